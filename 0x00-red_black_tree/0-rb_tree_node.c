@@ -1,5 +1,32 @@
 #include "rb_trees.h"
 
+/**
+ * rb_node_init - fill in a newly allocated RB tree node
+ *
+ * @node: node to fill in
+ * @parent: parent of the node
+ * @value: value of the node
+ * @color: color of the node
+ *
+ * Return: @node
+ */
+static rb_tree_t *rb_node_init(rb_tree_t *node, rb_tree_t *parent, int value,
+	rb_color_t color)
+{
+	node->n = value;
+	RB_SET_PARENT_COLOR(node, parent, color);
+	node->left = NULL;
+	node->right = NULL;
+#ifdef RB_MULTISET
+	node->count = 1;
+#endif
+#ifdef RB_INTERVAL
+	node->hi = value;
+#endif
+	RB_AUGMENT(node);
+	return (node);
+}
+
 /**
  * rb_tree_node - create an RB tree node
  *
@@ -16,10 +43,63 @@ rb_tree_t *rb_tree_node(rb_tree_t *parent, int value, rb_color_t color)
 	node = malloc(sizeof(rb_tree_t));
 	if (node == NULL)
 		return (NULL);
-	node->parent = parent;
-	node->n = value;
-	node->color = color;
-	node->left = NULL;
-	node->right = NULL;
-	return (node);
+	return (rb_node_init(node, parent, value, color));
+}
+
+/**
+ * rb_arena_node - create an RB tree node from an arena
+ *
+ * @arena: arena to allocate from, or NULL to use malloc
+ * @parent: parent of the node
+ * @value: value of the node
+ * @color: color of the node
+ *
+ * Return: pointer to the node, NULL on failure
+ */
+rb_tree_t *rb_arena_node(rb_arena_t *arena, rb_tree_t *parent, int value,
+	rb_color_t color)
+{
+	rb_tree_t *node;
+	rb_slab_t *slab;
+
+	if (arena == NULL)
+		return (rb_tree_node(parent, value, color));
+	if (arena->free_list != NULL)
+	{
+		/* Reuse a released node, free nodes are chained by right */
+		node = arena->free_list;
+		arena->free_list = node->right;
+	}
+	else
+	{
+		if (arena->used == arena->slab_size)
+		{
+			slab = malloc(sizeof(*slab) +
+				sizeof(rb_tree_t) * arena->slab_size);
+			if (slab == NULL)
+				return (NULL);
+			slab->next = arena->slabs;
+			arena->slabs = slab;
+			arena->used = 0;
+		}
+		node = (rb_tree_t *)(arena->slabs + 1) + arena->used++;
+	}
+	return (rb_node_init(node, parent, value, color));
+}
+
+/**
+ * rb_arena_free - release a node back to the arena it came from
+ *
+ * @arena: arena the node came from, or NULL if it came from malloc
+ * @node: node to release
+ */
+void rb_arena_free(rb_arena_t *arena, rb_tree_t *node)
+{
+	if (arena == NULL)
+	{
+		free(node);
+		return;
+	}
+	node->right = arena->free_list;
+	arena->free_list = node;
 }
@@ -1,47 +1,97 @@
 #include "rb_trees.h"
 
+/**
+ * rb_check_node - check the properties of an RB tree that only involve a
+ * node and its neighbors
+ *
+ * The node's color must be red or black, and not red under a red parent,
+ * its RB_KEY must lie between @lo and @hi, it must point back to its
+ * parent, and its augmented fields must match its children's.
+ *
+ * @node: node to check
+ * @parent: node's expected parent
+ * @lo: the key must be larger
+ * @hi: the key must be smaller
+ *
+ * Return: 1 if the node is valid, 0 otherwise
+ */
+int rb_check_node(const rb_tree_t *node, const rb_tree_t *parent,
+	long long lo, long long hi)
+{
+	if (RB_COLOR(node) != RED && RB_COLOR(node) != BLACK)
+		return (0);
+	if (RB_KEY(node) <= lo || RB_KEY(node) >= hi ||
+		RB_PARENT(node) != parent)
+		return (0);
+	if (IS_RED(node) && IS_RED(parent))
+		return (0);
+#ifdef RB_MULTISET
+	if (node->count == 0)
+		return (0);
+#endif
+#ifdef RB_ORDER_STAT
+	if (RB_SIZE(node) != RB_COUNT(node) + RB_SIZE(node->left) +
+		RB_SIZE(node->right))
+		return (0);
+#endif
+#ifdef RB_INTERVAL
+	if (node->hi < node->n || node->max < node->hi ||
+		(node->left != NULL && node->left->max > node->max) ||
+		(node->right != NULL && node->right->max > node->max) ||
+		(node->max != node->hi &&
+		(node->left == NULL || node->left->max != node->max) &&
+		(node->right == NULL || node->right->max != node->max)))
+		return (0);
+#endif
+	return (1);
+}
+
 /**
  * rb_tree_is_valid - check if a red-black tree is valid
  *
+ * Besides the colors and black heights, the key order, the parent
+ * pointers and the augmented fields are checked. The walk goes down left
+ * children and stacks the right ones. A valid tree is never deeper than
+ * RB_MAX_HEIGHT, so the stack has a fixed size and a deeper or cyclic
+ * tree is simply invalid. See rb_tree_validate to spread the walk over
+ * threads.
+ *
  * @tree: tree to check
  *
  * Return: 1 if valid tree, 0 if invalid tree
  */
 int rb_tree_is_valid(const rb_tree_t *tree)
 {
-	int left_blength, right_blength, blength;
+	rb_check_t stack[RB_MAX_HEIGHT], top;
+	const rb_tree_t *node;
+	size_t count = 1, height = 0;
 
-	if (tree == NULL)
+	if (tree == NULL || RB_PARENT(tree) != NULL || RB_COLOR(tree) != BLACK)
 		return (0);
-	left_blength = right_blength = blength = 0;
-	if (tree->left != NULL)
-		left_blength = rb_tree_is_valid(tree->left);
-	else
-		left_blength = 1;
-	if (tree->right != NULL)
-		right_blength = rb_tree_is_valid(tree->right);
-	else
-		right_blength = 1;
-	/* Check that black count is equal on both sides */
-	if (right_blength == left_blength)
+	stack[0] = (rb_check_t){tree, NULL, LLONG_MIN, LLONG_MAX, 0};
+	while (count > 0)
 	{
-		blength = right_blength;
-		if (tree->color == BLACK)
-			blength++;
+		top = stack[--count];
+		for (node = top.node; node != NULL; node = node->left)
+		{
+			if (!rb_check_node(node, top.parent, top.lo, top.hi))
+				return (0);
+			top.blacks += RB_COLOR(node) == BLACK;
+			if (node->right != NULL && count == RB_MAX_HEIGHT)
+				return (0);
+			if (node->right != NULL)
+				stack[count++] = (rb_check_t){node->right, node,
+					RB_KEY(node), top.hi, top.blacks};
+			else if (height == 0)
+				height = top.blacks;
+			else if (height != top.blacks)
+				return (0);
+			top.parent = node, top.hi = RB_KEY(node);
+		}
+		if (height == 0)
+			height = top.blacks;
+		else if (height != top.blacks)
+			return (0);
 	}
-	else
-		blength = 0;
-	/* Check if root node is black */
-	if (tree->parent == NULL && tree->color != BLACK)
-		blength = 0;
-	/* Check that the color is either red or black */
-	if (tree->color != BLACK && tree->color != RED)
-		blength = 0;
-	/* Check that there are no adjacent reds */
-	if (tree->parent && tree->color == RED && tree->parent->color == RED)
-		blength = 0;
-	/* Convert blength to 1 if tree is valid */
-	if (tree->parent == NULL && blength != 0)
-		return (1);
-	return (blength);
+	return (1);
 }
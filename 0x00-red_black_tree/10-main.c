@@ -0,0 +1,32 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree;
+    rb_tree_t *out[6];
+    int array[] = {
+        79, 47, 68, 87, 84, 91, 21, 32, 34, 2,
+        20, 22, 98, 1, 62, 95
+    };
+    int keys[] = { 47, 48, 1, 95, 0, 62 };
+    size_t n = sizeof(array) / sizeof(array[0]);
+    size_t i, found;
+
+    tree = array_to_rb_tree(array, n);
+    if (!tree)
+        return (1);
+    printf("Find 84: %d\n", rb_tree_find(tree, 84)->n);
+    printf("Find 85: %p\n", (void *)rb_tree_find(tree, 85));
+    found = rb_tree_find_many(tree, keys, 6, out);
+    for (i = 0; i < 6; i++)
+        printf("Key %d: %s\n", keys[i], out[i] ? "found" : "not found");
+    printf("Found %lu keys\n", found);
+    rb_tree_delete(tree);
+    return (0);
+}
@@ -0,0 +1,93 @@
+#include "rb_trees.h"
+
+/**
+ * rb_tree_find - find the node holding a value in an RB tree
+ *
+ * @tree: root of the tree
+ * @n: value to find
+ *
+ * Return: node holding @n, NULL if not found
+ */
+rb_tree_t *rb_tree_find(rb_tree_t *tree, int n)
+{
+	while (tree != NULL && tree->n != n)
+		tree = RB_LINK(tree, tree->n < n);
+	return (tree);
+}
+
+/**
+ * rb_find_group - run up to RB_FIND_BATCH searches in lockstep
+ *
+ * Each round moves every unfinished search down one level and prefetches
+ * the node it will read next, so the cache misses of the whole group are
+ * in flight at the same time instead of one after the other.
+ *
+ * @tree: root of the tree
+ * @keys: values to find
+ * @count: number of values, at most RB_FIND_BATCH
+ * @out: receives the node holding each value, or NULL
+ *
+ * Return: number of values found
+ */
+static size_t rb_find_group(rb_tree_t *tree, const int *keys, size_t count,
+	rb_tree_t **out)
+{
+	rb_tree_t *cur[RB_FIND_BATCH];
+	size_t i, active, found = 0;
+
+	for (i = 0; i < count; i++)
+		cur[i] = tree;
+	for (active = count; active > 0;)
+	{
+		for (i = 0; i < count; i++)
+		{
+			if (cur[i] == NULL)
+				continue;
+			if (cur[i]->n == keys[i])
+			{
+				out[i] = cur[i];
+				cur[i] = NULL;
+				found++, active--;
+				continue;
+			}
+			cur[i] = RB_LINK(cur[i], cur[i]->n < keys[i]);
+			if (cur[i] == NULL)
+				out[i] = NULL, active--;
+			else
+				RB_PREFETCH(cur[i]);
+		}
+	}
+	return (found);
+}
+
+/**
+ * rb_tree_find_many - find the nodes holding several values in an RB tree,
+ * overlapping the memory latency of the searches
+ *
+ * @tree: root of the tree
+ * @keys: values to find
+ * @n: number of values
+ * @out: array of @n pointers receiving the node holding each value, or NULL
+ *
+ * Return: number of values found
+ */
+size_t rb_tree_find_many(rb_tree_t *tree, const int *keys, size_t n,
+	rb_tree_t **out)
+{
+	size_t i, count, found = 0;
+
+	if (keys == NULL || out == NULL)
+		return (0);
+	if (tree == NULL)
+	{
+		for (i = 0; i < n; i++)
+			out[i] = NULL;
+		return (0);
+	}
+	for (i = 0; i < n; i += count)
+	{
+		count = n - i < RB_FIND_BATCH ? n - i : RB_FIND_BATCH;
+		found += rb_find_group(tree, keys + i, count, out + i);
+	}
+	return (found);
+}
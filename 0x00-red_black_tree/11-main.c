@@ -0,0 +1,50 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+void rb_tree_print(const rb_tree_t *tree);
+
+/**
+ * print_node - prints the key of a node
+ *
+ * @node: node to print
+ * @data: unused
+ */
+void print_node(const rb_tree_t *node, void *data)
+{
+    (void)data;
+    printf(" %d", node->n);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree;
+    rb_tree_t *node;
+    int array[] = {
+        79, 47, 68, 87, 84, 91, 21, 32, 34, 2,
+        20, 22, 98, 1, 62, 95
+    };
+    size_t n = sizeof(array) / sizeof(array[0]);
+    size_t count;
+
+    tree = array_to_rb_tree(array, n);
+    if (!tree)
+        return (1);
+    rb_tree_print(tree);
+    printf("Forward:");
+    for (node = rb_tree_lower_bound(tree, 0); node; node = rb_tree_next(node))
+        printf(" %d", node->n);
+    printf("\nBackward from 50:");
+    node = rb_tree_lower_bound(tree, 50);
+    for (node = rb_tree_prev(node); node; node = rb_tree_prev(node))
+        printf(" %d", node->n);
+    printf("\nRange [30, 90]:");
+    count = rb_tree_foreach_range(tree, 30, 90, print_node, NULL);
+    printf("\nVisited %lu nodes\n", count);
+    rb_tree_delete(tree);
+    return (0);
+}
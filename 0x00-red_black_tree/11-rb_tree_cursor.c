@@ -0,0 +1,117 @@
+#include "rb_trees.h"
+
+/**
+ * rb_tree_lower_bound - find the first node of an RB tree whose key is not
+ * smaller than a value
+ *
+ * @tree: root of the tree
+ * @n: value to seek to
+ *
+ * Return: node holding the smallest key >= @n, NULL if there is none
+ */
+rb_tree_t *rb_tree_lower_bound(rb_tree_t *tree, int n)
+{
+	rb_tree_t *bound = NULL;
+
+	while (tree != NULL)
+	{
+		if (tree->n < n)
+			tree = tree->right;
+		else
+		{
+			bound = tree;
+			tree = tree->left;
+		}
+	}
+	return (bound);
+}
+
+/**
+ * rb_tree_next - step to the in-order successor of a node
+ *
+ * Walks the parent links, so a full scan costs O(1) amortized per step
+ * and needs no stack.
+ *
+ * @node: current node
+ *
+ * Return: node holding the next larger key, NULL after the last node
+ */
+rb_tree_t *rb_tree_next(rb_tree_t *node)
+{
+	rb_tree_t *parent;
+
+	if (node == NULL)
+		return (NULL);
+	if (node->right != NULL)
+	{
+		for (node = node->right; node->left != NULL; node = node->left)
+			;
+		return (node);
+	}
+	parent = RB_PARENT(node);
+	while (parent != NULL && node == parent->right)
+	{
+		node = parent;
+		parent = RB_PARENT(node);
+	}
+	return (parent);
+}
+
+/**
+ * rb_tree_prev - step to the in-order predecessor of a node
+ *
+ * @node: current node
+ *
+ * Return: node holding the next smaller key, NULL before the first node
+ */
+rb_tree_t *rb_tree_prev(rb_tree_t *node)
+{
+	rb_tree_t *parent;
+
+	if (node == NULL)
+		return (NULL);
+	if (node->left != NULL)
+	{
+		for (node = node->left; node->right != NULL; node = node->right)
+			;
+		return (node);
+	}
+	parent = RB_PARENT(node);
+	while (parent != NULL && node == parent->left)
+	{
+		node = parent;
+		parent = RB_PARENT(node);
+	}
+	return (parent);
+}
+
+/**
+ * rb_tree_foreach_range - visit in order every node of an RB tree whose
+ * key lies in a closed range
+ *
+ * Only the path to @lo and the nodes in the range are touched.
+ *
+ * @tree: root of the tree
+ * @lo: lower bound of the range
+ * @hi: upper bound of the range
+ * @action: function called on each node in the range
+ * @data: argument passed through to @action
+ *
+ * Return: number of nodes visited
+ */
+size_t rb_tree_foreach_range(rb_tree_t *tree, int lo, int hi,
+	void (*action)(const rb_tree_t *node, void *data), void *data)
+{
+	rb_tree_t *node;
+	size_t count = 0;
+
+	if (action == NULL || lo > hi)
+		return (0);
+	for (node = rb_tree_lower_bound(tree, lo);
+		node != NULL && node->n <= hi; node = rb_tree_next(node))
+	{
+		action(node, data);
+		count++;
+	}
+	return (count);
+}
@@ -0,0 +1,41 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+void rb_tree_print(const rb_tree_t *tree);
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree, *lo, *hi, *pivot, *other;
+    int array[] = {
+        79, 47, 68, 87, 84, 91, 21, 32, 34, 2,
+        20, 22, 98, 1, 62, 95
+    };
+    int more[] = { 5, 47, 50, 62, 99 };
+    size_t n = sizeof(array) / sizeof(array[0]);
+
+    tree = array_to_rb_tree(array, n);
+    if (!tree)
+        return (1);
+    pivot = rb_tree_split(tree, 47, &lo, &hi);
+    printf("Split around %d\n", pivot->n);
+    rb_tree_print(lo);
+    rb_tree_print(hi);
+    tree = rb_tree_join(lo, pivot, hi);
+    printf("Joined back, valid: %d\n", rb_tree_is_valid(tree));
+    rb_tree_print(tree);
+    other = array_to_rb_tree(more, 5);
+    tree = rb_tree_union(tree, other);
+    printf("Union with {5, 47, 50, 62, 99}\n");
+    rb_tree_print(tree);
+    other = array_to_rb_tree(more, 5);
+    tree = rb_tree_difference(tree, other);
+    printf("Difference with {5, 47, 50, 62, 99}\n");
+    rb_tree_print(tree);
+    rb_tree_delete(tree);
+    return (0);
+}
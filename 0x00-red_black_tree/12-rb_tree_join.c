@@ -0,0 +1,176 @@
+#include "rb_trees.h"
+
+/**
+ * rb_black_height - count the black nodes on any path from a node down to
+ * a leaf, the node included
+ *
+ * @tree: root of the tree
+ *
+ * Return: black height of @tree, 0 for an empty tree
+ */
+size_t rb_black_height(const rb_tree_t *tree)
+{
+	size_t height = 0;
+
+	for (; tree != NULL; tree = tree->left)
+		height += RB_COLOR(tree) == BLACK;
+	return (height);
+}
+
+/**
+ * rb_tree_join - join two RB trees and a pivot node into one tree
+ *
+ * Every key of @left must be smaller than the pivot's, and every key of
+ * @right larger. The black heights of both trees are counted first, which
+ * walks their spines. Code that splits and joins repeatedly keeps them in
+ * rb_part_t instead and calls rb_join_parts.
+ *
+ * @left: root of the tree holding the smaller keys
+ * @pivot: detached node holding the middle key
+ * @right: root of the tree holding the larger keys
+ *
+ * Return: root of the joined tree
+ */
+rb_tree_t *rb_tree_join(rb_tree_t *left, rb_tree_t *pivot, rb_tree_t *right)
+{
+	rb_part_t lo = {NULL, 0}, hi = {NULL, 0};
+
+	if (left != NULL)
+		RB_SET_COLOR(left, BLACK);
+	if (right != NULL)
+		RB_SET_COLOR(right, BLACK);
+	lo.root = left, lo.bh = rb_black_height(left);
+	hi.root = right, hi.bh = rb_black_height(right);
+	if (pivot == NULL)
+		return (rb_concat_parts(lo, hi).root);
+	return (rb_join_parts(lo, pivot, hi).root);
+}
+
+/**
+ * rb_join_parts - join two RB trees of known black heights and a pivot
+ * node into one tree
+ *
+ * The pivot is hung red off the spine of the taller tree at the black
+ * height of the shorter one and repaired from there up, so this runs in
+ * O(|bh(left) - bh(right)| + 1).
+ *
+ * @left: tree holding the smaller keys, its root black
+ * @pivot: detached node holding the middle key
+ * @right: tree holding the larger keys, its root black
+ *
+ * Return: the joined tree and its black height
+ */
+rb_part_t rb_join_parts(rb_part_t left, rb_tree_t *pivot, rb_part_t right)
+{
+	rb_tree_t *parent = NULL, *cur, *other;
+	rb_part_t tall;
+	size_t bh;
+	int dir = left.bh > right.bh;
+
+	if (left.bh == right.bh)
+	{
+		pivot->left = left.root;
+		pivot->right = right.root;
+		RB_SET_PARENT_COLOR(pivot, NULL, BLACK);
+		if (left.root != NULL)
+			RB_SET_PARENT(left.root, pivot);
+		if (right.root != NULL)
+			RB_SET_PARENT(right.root, pivot);
+		RB_AUGMENT(pivot);
+		return ((rb_part_t){pivot, left.bh + 1});
+	}
+	tall = dir ? left : right;
+	other = dir ? right.root : left.root;
+	/* Find the first black node whose black height matches @other */
+	for (cur = tall.root, bh = tall.bh; cur != NULL && (IS_RED(cur) ||
+		bh > (dir ? right.bh : left.bh)); cur = RB_LINK(cur, dir))
+	{
+		bh -= RB_COLOR(cur) == BLACK;
+		parent = cur;
+	}
+	RB_LINK(pivot, !dir) = cur;
+	RB_LINK(pivot, dir) = other;
+	RB_SET_PARENT_COLOR(pivot, parent, RED);
+	if (cur != NULL)
+		RB_SET_PARENT(cur, pivot);
+	if (other != NULL)
+		RB_SET_PARENT(other, pivot);
+	RB_LINK(parent, dir) = pivot;
+	RB_AUGMENT(pivot);
+	RB_AUGMENT_PATH(parent);
+	tall.bh += rb_insert_fixup(&tall.root, pivot);
+	return (tall);
+}
+
+/**
+ * rb_insert_fixup - restore the RB properties bottom-up after a red node
+ * was linked into a tree
+ *
+ * @root: pointer to the root of the tree, updated if it changes
+ * @node: red node that was linked
+ *
+ * Return: 1 if the root had to be blackened, which adds one to the black
+ * height of the tree, 0 otherwise
+ */
+int rb_insert_fixup(rb_tree_t **root, rb_tree_t *node)
+{
+	int grew;
+
+	rb_tree_t *p, *g, *u;
+	int dir;
+
+	while ((p = RB_PARENT(node)) != NULL && IS_RED(p))
+	{
+		g = RB_PARENT(p);
+		if (g == NULL)
+			break;
+		dir = g->right == p;
+		u = RB_LINK(g, !dir);
+		if (IS_RED(u))
+		{
+			/* Color flip and continue from the grandparent */
+			RB_STAT(color_flips, 1);
+			RB_SET_COLOR(p, BLACK);
+			RB_SET_COLOR(u, BLACK);
+			RB_SET_COLOR(g, RED);
+			node = g;
+			continue;
+		}
+		if (node == RB_LINK(p, !dir))
+		{
+			/* Move the inner child to the outside */
+			rb_rotate(root, p, dir);
+			p = node;
+		}
+		RB_SET_COLOR(p, BLACK);
+		RB_SET_COLOR(g, RED);
+		rb_rotate(root, g, !dir);
+		break;
+	}
+	grew = IS_RED(*root);
+	RB_SET_COLOR(*root, BLACK);
+	return (grew);
+}
+
+/**
+ * rb_rotate - rotate a tree at a node and link the new subtree root back
+ * into the node's parent
+ *
+ * @root: pointer to the root of the tree, updated if it changes
+ * @node: node to rotate at
+ * @dir: direction to rotate. 1 is right, 0 is left
+ *
+ * Return: the new subtree root
+ */
+rb_tree_t *rb_rotate(rb_tree_t **root, rb_tree_t *node, int dir)
+{
+	rb_tree_t *parent = RB_PARENT(node), *top;
+	int side = parent != NULL && parent->right == node;
+
+	top = single_rotate_color_swap(node, dir, NO_COLOR_SWAP);
+	if (parent == NULL)
+		*root = top;
+	else
+		RB_LINK(parent, side) = top;
+	return (top);
+}
@@ -0,0 +1,134 @@
+#include "rb_trees.h"
+
+/**
+ * rb_detach - turn a child subtree into a standalone tree. Its root is
+ * blackened, which keeps the black heights of its paths equal
+ *
+ * @tree: root of the subtree
+ * @bh: black height of @tree before its root is blackened
+ *
+ * Return: @tree and its black height as a standalone tree
+ */
+rb_part_t rb_detach(rb_tree_t *tree, size_t bh)
+{
+	rb_part_t part = {tree, bh};
+
+	if (tree != NULL)
+	{
+		part.bh += IS_RED(tree);
+		RB_SET_PARENT_COLOR(tree, NULL, BLACK);
+	}
+	return (part);
+}
+
+/**
+ * rb_tree_split - split an RB tree around a key
+ *
+ * @tree: root of the tree to split, consumed
+ * @n: key to split around
+ * @lo: receives the tree of keys smaller than @n
+ * @hi: receives the tree of keys larger than @n
+ *
+ * Return: the detached node holding @n, NULL if @n was not in the tree
+ */
+rb_tree_t *rb_tree_split(rb_tree_t *tree, int n, rb_tree_t **lo,
+	rb_tree_t **hi)
+{
+	rb_part_t whole = {tree, rb_black_height(tree)}, left, right;
+	rb_tree_t *found;
+
+	found = rb_split_parts(whole, RB_KEY_OF(n), &left, &right);
+	*lo = left.root;
+	*hi = right.root;
+	return (found);
+}
+
+/**
+ * rb_split_parts - split an RB tree of known black height around a key
+ *
+ * The tree is taken apart along the search path for @key and the pieces
+ * on each side are joined back together. The black height of every piece
+ * follows from its parent's, and each join costs the difference of the
+ * heights it joins, so the whole split runs in O(log(n)).
+ *
+ * @tree: tree to split, consumed
+ * @key: key to split around, as given by RB_KEY_OF or RB_KEY
+ * @lo: receives the tree of keys smaller than @key
+ * @hi: receives the tree of keys larger than @key
+ *
+ * Return: the detached node holding @key, NULL if @key was not in the tree
+ */
+rb_tree_t *rb_split_parts(rb_part_t tree, long long key, rb_part_t *lo,
+	rb_part_t *hi)
+{
+	rb_part_t left, right, rest;
+	rb_tree_t *node = tree.root, *found;
+	size_t bh;
+
+	if (node == NULL)
+	{
+		*lo = *hi = tree;
+		return (NULL);
+	}
+	bh = tree.bh - (RB_COLOR(node) == BLACK);
+	left = rb_detach(node->left, bh);
+	right = rb_detach(node->right, bh);
+	node->left = node->right = NULL;
+	RB_SET_PARENT(node, NULL);
+	if (key == RB_KEY(node))
+	{
+		*lo = left;
+		*hi = right;
+		RB_AUGMENT(node);
+		return (node);
+	}
+	if (key < RB_KEY(node))
+	{
+		found = rb_split_parts(left, key, lo, &rest);
+		*hi = rb_join_parts(rest, node, right);
+	}
+	else
+	{
+		found = rb_split_parts(right, key, &rest, hi);
+		*lo = rb_join_parts(left, node, rest);
+	}
+	return (found);
+}
+
+/**
+ * rb_tree_concat - join two RB trees without a pivot node
+ *
+ * @left: root of the tree holding the smaller keys
+ * @right: root of the tree holding the larger keys
+ *
+ * Return: root of the joined tree
+ */
+rb_tree_t *rb_tree_concat(rb_tree_t *left, rb_tree_t *right)
+{
+	return (rb_tree_join(left, NULL, right));
+}
+
+/**
+ * rb_concat_parts - join two RB trees of known black heights without a
+ * pivot node, in O(log(n))
+ *
+ * @left: tree holding the smaller keys
+ * @right: tree holding the larger keys
+ *
+ * Return: the joined tree and its black height
+ */
+rb_part_t rb_concat_parts(rb_part_t left, rb_part_t right)
+{
+	rb_part_t rest;
+	rb_tree_t *max;
+
+	if (left.root == NULL)
+		return (right);
+	if (right.root == NULL)
+		return (left);
+	/* Use the largest key of @left as the pivot */
+	for (max = left.root; max->right != NULL; max = max->right)
+		;
+	max = rb_split_parts(left, RB_KEY(max), &left, &rest);
+	return (rb_join_parts(left, max, right));
+}
@@ -0,0 +1,116 @@
+#include <pthread.h>
+#include "rb_trees.h"
+
+/**
+ * rb_setop_base - finish a set operation when one of its trees is empty
+ *
+ * @job: set operation to finish
+ *
+ * Return: 1 if @job is finished, 0 otherwise
+ */
+static int rb_setop_base(rb_setop_t *job)
+{
+	if (job->a.root != NULL && job->b.root != NULL)
+		return (0);
+	if (job->op == RB_UNION)
+		job->result = job->a.root != NULL ? job->a : job->b;
+	else if (job->op == RB_DIFFERENCE && job->a.root != NULL)
+		job->result = job->a;
+	else
+	{
+		rb_tree_delete_arena(job->arena, job->a.root);
+		rb_tree_delete_arena(job->arena, job->b.root);
+		job->result.root = NULL;
+		job->result.bh = 0;
+	}
+	return (1);
+}
+
+/**
+ * rb_setop_fork - run two independent set operations, the first one on a
+ * new thread when its trees are large and the fork depth allows it
+ *
+ * Arenas are not thread-safe, so jobs freeing nodes to one never fork.
+ *
+ * @left: first set operation
+ * @right: second set operation
+ */
+static void rb_setop_fork(rb_setop_t *left, rb_setop_t *right)
+{
+	pthread_t thread;
+	int forked = 0;
+
+	if (left->arena == NULL && left->depth < RB_SETOP_FORK_DEPTH &&
+		left->a.bh + left->b.bh >= RB_SETOP_FORK_BH)
+		forked = pthread_create(&thread, NULL, rb_setop, left) == 0;
+	if (!forked)
+		rb_setop(left);
+	rb_setop(right);
+	if (forked)
+		pthread_join(thread, NULL);
+}
+
+/**
+ * rb_setop_keep - decide which node to keep as the pivot of a set
+ * operation's result, freeing the others
+ *
+ * @job: set operation
+ * @pivot: root node that the other tree was split around
+ * @dup: node of the other tree holding the same key, or NULL
+ *
+ * Return: node to join the two halves of the result with, or NULL
+ */
+static rb_tree_t *rb_setop_keep(const rb_setop_t *job, rb_tree_t *pivot,
+	rb_tree_t *dup)
+{
+	rb_tree_t *keep = NULL;
+
+	if (job->op == RB_UNION || (job->op == RB_INTERSECTION && dup != NULL))
+		keep = pivot;
+	else
+		rb_arena_free(job->arena, pivot);
+	if (dup != NULL)
+		rb_arena_free(job->arena, dup);
+	return (keep);
+}
+
+/**
+ * rb_setop - run a set operation by splitting one tree around the root of
+ * the other and recursing on both halves
+ *
+ * Union and intersection split @b around the root of @a, difference splits
+ * @a around the root of @b. Both trees are consumed. Black heights are
+ * carried along, so no split or join has to count them.
+ *
+ * @arg: pointer to the rb_setop_t job, whose result is filled in
+ *
+ * Return: NULL, so it can be used as a thread routine
+ */
+void *rb_setop(void *arg)
+{
+	rb_setop_t *job = arg, left, right;
+	rb_tree_t *pivot, *dup;
+	rb_part_t *root, *split;
+	size_t bh;
+	int diff = job->op == RB_DIFFERENCE;
+
+	if (rb_setop_base(job))
+		return (NULL);
+	root = diff ? &job->b : &job->a;
+	split = diff ? &job->a : &job->b;
+	pivot = root->root;
+	bh = root->bh - (RB_COLOR(pivot) == BLACK);
+	left = right = *job;
+	left.depth = right.depth = job->depth + 1;
+	*(diff ? &left.b : &left.a) = rb_detach(pivot->left, bh);
+	*(diff ? &right.b : &right.a) = rb_detach(pivot->right, bh);
+	dup = rb_split_parts(*split, RB_KEY(pivot), diff ? &left.a : &left.b,
+		diff ? &right.a : &right.b);
+	rb_setop_fork(&left, &right);
+	pivot = rb_setop_keep(job, pivot, dup);
+	if (pivot != NULL)
+		job->result = rb_join_parts(left.result, pivot, right.result);
+	else
+		job->result = rb_concat_parts(left.result, right.result);
+	return (NULL);
+}
@@ -0,0 +1,49 @@
+#include "rb_trees.h"
+
+/**
+ * rb_tree_union - merge two RB trees into the tree of keys found in either
+ *
+ * Both trees are consumed, nodes of duplicate keys are freed. Runs in
+ * O(m log(n / m + 1)) for trees of sizes m <= n, with large independent
+ * subproblems handed to worker threads.
+ *
+ * @a: root of the first tree
+ * @b: root of the second tree
+ *
+ * Return: root of the union
+ */
+rb_tree_t *rb_tree_union(rb_tree_t *a, rb_tree_t *b)
+{
+	return (rb_tree_union_arena(NULL, a, b));
+}
+
+/**
+ * rb_tree_intersection - merge two RB trees into the tree of keys found in
+ * both
+ *
+ * Both trees are consumed, nodes that are not kept are freed.
+ *
+ * @a: root of the first tree
+ * @b: root of the second tree
+ *
+ * Return: root of the intersection
+ */
+rb_tree_t *rb_tree_intersection(rb_tree_t *a, rb_tree_t *b)
+{
+	return (rb_tree_intersection_arena(NULL, a, b));
+}
+
+/**
+ * rb_tree_difference - remove from an RB tree every key found in another
+ *
+ * Both trees are consumed, nodes that are not kept are freed.
+ *
+ * @a: root of the tree to remove keys from
+ * @b: root of the tree of keys to remove
+ *
+ * Return: root of the difference
+ */
+rb_tree_t *rb_tree_difference(rb_tree_t *a, rb_tree_t *b)
+{
+	return (rb_tree_difference_arena(NULL, a, b));
+}
@@ -0,0 +1,33 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+void rb_tree_print(const rb_tree_t *tree);
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *root = NULL;
+    rb_hint_t hint = {NULL, {NULL, NULL}, 0};
+    rb_tree_t *node;
+    int stream[] = {
+        10, 11, 12, 14, 13, 15, 16, 18, 17, 20,
+        19, 21, 22, 22, 23
+    };
+    size_t n = sizeof(stream) / sizeof(stream[0]);
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        node = rb_tree_insert_hint(&root, &hint, stream[i]);
+        if (!node)
+            printf("Already in tree: %d\n", stream[i]);
+    }
+    rb_tree_print(root);
+    printf("Is valid: %d\n", rb_tree_is_valid(root));
+    rb_tree_delete(root);
+    return (0);
+}
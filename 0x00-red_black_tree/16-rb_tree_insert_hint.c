@@ -0,0 +1,172 @@
+#include "rb_trees.h"
+
+/**
+ * rb_hint_start - find the node below which a value must be placed,
+ * starting from a hint
+ *
+ * If @n is larger than the hint, the hint's ancestors reached through
+ * right links are smaller still, and the first ancestor reached through
+ * a left link is the hint's successor. When @n is below that successor
+ * (or there is none), @n belongs in the hint's right subtree. Otherwise
+ * the search moves on to the successor. Smaller values are symmetric.
+ * The climb only reads parent links, no node is restructured.
+ *
+ * @node: hint node
+ * @key: key of the value to place, as given by RB_KEY_OF
+ *
+ * Return: node to start the downward search from
+ */
+static rb_tree_t *rb_hint_start(rb_tree_t *node, long long key)
+{
+	rb_tree_t *bound, *child;
+	int dir;
+
+	while (RB_KEY(node) != key)
+	{
+		dir = RB_KEY(node) < key;
+		child = node;
+		bound = RB_PARENT(child);
+		while (bound != NULL && RB_LINK(bound, dir) == child)
+		{
+			child = bound;
+			bound = RB_PARENT(child);
+		}
+		if (bound == NULL ||
+			(dir ? key < RB_KEY(bound) : key > RB_KEY(bound)))
+			return (node);
+		node = bound;
+	}
+	return (node);
+}
+
+/**
+ * rb_hint_gap - find where a value goes when it lands next to the node of
+ * a hint, between that node and its predecessor or successor
+ *
+ * Two nodes next to each other in order can't both have a child on the
+ * side facing the other, so the value always hangs from one of them. A
+ * neighbor the hint doesn't know yet is looked up once and remembered.
+ *
+ * @hint: hint of the last insert
+ * @key: key of the value to place, as given by RB_KEY_OF
+ * @dir: receives the side to link the value on, -1 if the node returned
+ * already holds @key
+ *
+ * Return: node to link the value under or holding it, NULL if @key is
+ * not next to the hint
+ */
+static rb_tree_t *rb_hint_gap(rb_hint_t *hint, long long key, int *dir)
+{
+	rb_tree_t *node = hint->node, *near;
+	int side = RB_KEY(node) < key;
+
+	*dir = -1;
+	if (RB_KEY(node) == key)
+		return (node);
+	if (!(hint->known & (1 << side)))
+	{
+		hint->near[side] = side ? rb_tree_next(node) : rb_tree_prev(node);
+		hint->known |= 1 << side;
+	}
+	near = hint->near[side];
+	if (near != NULL && RB_KEY(near) == key)
+		return (near);
+	if (near != NULL && (side ? RB_KEY(near) < key : RB_KEY(near) > key))
+		return (NULL);
+	if (RB_LINK(node, side) == NULL)
+	{
+		*dir = side;
+		return (node);
+	}
+	*dir = !side;
+	return (near);
+}
+
+/**
+ * rb_hint_set - move a hint to a node
+ *
+ * @hint: hint to move
+ * @node: node of the tree
+ * @prev: in-order predecessor of @node, if known
+ * @next: in-order successor of @node, if known
+ * @known: bit 0 set if @prev is known, bit 1 if @next is
+ */
+static void rb_hint_set(rb_hint_t *hint, rb_tree_t *node, rb_tree_t *prev,
+	rb_tree_t *next, int known)
+{
+	hint->node = node;
+	hint->near[0] = prev;
+	hint->near[1] = next;
+	hint->known = known;
+}
+
+/**
+ * rb_tree_insert_hint - insert a value into an RB tree, starting the
+ * search from where the previous value went
+ *
+ * Meant for key streams where each key lands next to the previous one.
+ * The hint remembers the node of the last call and its neighbors in
+ * order, so a key falling between them is linked directly, in O(1), and
+ * the tree is repaired bottom-up in amortized O(1) rotations and
+ * recolorings. Other keys are searched from the hint, climbing only as
+ * far as needed. Reset the hint's node to NULL after changing the tree in
+ * any other way.
+ *
+ * @tree: pointer to root node of tree
+ * @hint: hint moved to the node of @n, its node NULL to search from the
+ * root
+ * @n: data to insert
+ *
+ * Return: node inserted, NULL if @n is already in the tree or on failure.
+ * In multiset mode, the node holding @n, NULL only on failure
+ */
+rb_tree_t *rb_tree_insert_hint(rb_tree_t **tree, rb_hint_t *hint, int n)
+{
+	rb_tree_t *parent = NULL, *cur = NULL, *node, *near[2] = {NULL, NULL};
+	long long key = RB_KEY_OF(n);
+	int dir = -1, known = 3, side;
+
+	if (tree == NULL || hint == NULL)
+		return (NULL);
+	if (*tree != NULL && hint->node != NULL)
+		parent = rb_hint_gap(hint, key, &dir);
+	if (parent != NULL && dir != -1)
+	{
+		/* The value lands between the hint's node and a neighbor */
+		side = RB_KEY(hint->node) < key;
+		near[!side] = hint->node, near[side] = hint->near[side];
+	}
+	else if (parent != NULL)
+		cur = parent;
+	else
+	{
+		cur = hint->node != NULL && *tree != NULL ?
+			rb_hint_start(hint->node, key) : *tree;
+		for (; cur != NULL && RB_KEY(cur) != key; cur = RB_LINK(cur, dir))
+			parent = cur, dir = RB_KEY(cur) < key;
+		if (parent != NULL)
+			near[!dir] = parent, known = 1 << !dir;
+	}
+	if (cur != NULL)
+	{
+		rb_hint_set(hint, cur, NULL, NULL, 0);
+#ifdef RB_MULTISET
+		cur->count++;
+		RB_AUGMENT_PATH(cur);
+		return (cur);
+#else
+		return (NULL);
+#endif
+	}
+	node = rb_tree_node(parent, n, RED);
+	if (node == NULL)
+		return (NULL);
+	if (parent == NULL)
+		*tree = node;
+	else
+		RB_LINK(parent, dir) = node;
+	rb_hint_set(hint, node, near[0], near[1], known);
+	RB_AUGMENT_PATH(parent);
+	rb_insert_fixup(tree, node);
+	return (node);
+}
@@ -0,0 +1,51 @@
+#include "rb_trees.h"
+
+/**
+ * rb_tree_remove_range - remove every key of an RB tree in a closed range
+ *
+ * @root: root of tree
+ * @lo: lower bound of the range
+ * @hi: upper bound of the range
+ *
+ * Return: root of tree
+ */
+rb_tree_t *rb_tree_remove_range(rb_tree_t *root, int lo, int hi)
+{
+	return (rb_tree_remove_range_arena(NULL, root, lo, hi));
+}
+
+/**
+ * rb_tree_remove_range_arena - remove every key of an RB tree in a closed
+ * range, releasing the nodes to an arena
+ *
+ * The range is cut out with two splits and the remaining halves are joined
+ * back, so the tree is restructured in O(log(n)) and each removed node
+ * costs one step of a plain sweep, for O(log(n) + k) overall. In an
+ * interval tree, the intervals removed are the ones whose low endpoint is
+ * in the range.
+ *
+ * @arena: arena the nodes came from, or NULL if they came from malloc
+ * @root: root of tree
+ * @lo: lower bound of the range
+ * @hi: upper bound of the range
+ *
+ * Return: root of tree
+ */
+rb_tree_t *rb_tree_remove_range_arena(rb_arena_t *arena, rb_tree_t *root,
+	int lo, int hi)
+{
+	rb_part_t whole = {root, rb_black_height(root)}, left, mid, right;
+	rb_tree_t *node;
+
+	if (root == NULL || lo > hi)
+		return (root);
+	node = rb_split_parts(whole, RB_KEY_OF(lo), &left, &mid);
+	if (node != NULL)
+		rb_arena_free(arena, node);
+	node = rb_split_parts(mid, RB_KEY_LAST(hi), &mid, &right);
+	if (node != NULL)
+		rb_arena_free(arena, node);
+	rb_tree_delete_arena(arena, mid.root);
+
+	return (rb_concat_parts(left, right).root);
+}
@@ -0,0 +1,54 @@
+#include <stdlib.h>
+#include "rb_store.h"
+
+/**
+ * print_snapshot - print the values of a snapshot in order. Snapshots do
+ * not keep parent links, so only child links are followed
+ *
+ * @tree: root of the snapshot
+ */
+void print_snapshot(const rb_tree_t *tree)
+{
+    if (!tree)
+        return;
+    print_snapshot(tree->left);
+    printf("%d%c ", tree->n, RB_COLOR(tree) == RED ? 'R' : 'B');
+    print_snapshot(tree->right);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_store_t *store;
+    rb_tree_t *snapshot;
+    int array[] = {
+        79, 47, 68, 87, 84, 91, 21, 32, 34, 2,
+        20, 22, 98, 1, 62, 95
+    };
+    size_t n = sizeof(array) / sizeof(array[0]);
+    size_t i;
+    int slot;
+
+    store = rb_store_create(array_to_rb_tree(array, n));
+    if (!store)
+        return (1);
+    snapshot = rb_snapshot_acquire(store, &slot);
+    for (i = 0; i < n; i++)
+        rb_store_remove(store, array[i] % 2 ? array[i] : -1);
+    rb_store_insert(store, 50);
+    printf("Snapshot:\n");
+    print_snapshot(snapshot);
+    printf("\n");
+    rb_snapshot_release(store, slot);
+    snapshot = rb_snapshot_acquire(store, &slot);
+    printf("Removed odd values, inserted 50:\n");
+    print_snapshot(snapshot);
+    printf("\n");
+    rb_snapshot_release(store, slot);
+    rb_store_destroy(store);
+    return (0);
+}
@@ -0,0 +1,139 @@
+#include "rb_store.h"
+
+/**
+ * rb_store_create - create a store sharing a persistent RB tree between
+ * lock-free readers and a writer
+ *
+ * @root: root of the initial tree, owned by the store from now on
+ *
+ * Return: pointer to the store, NULL on failure
+ */
+rb_store_t *rb_store_create(rb_tree_t *root)
+{
+	rb_store_t *store;
+	int i;
+
+	store = malloc(sizeof(*store));
+	if (store == NULL)
+		return (NULL);
+	if (pthread_mutex_init(&store->lock, NULL) != 0)
+	{
+		free(store);
+		return (NULL);
+	}
+	atomic_init(&store->root, root);
+	atomic_init(&store->epoch, 1);
+	for (i = 0; i < RB_STORE_READERS; i++)
+		atomic_init(&store->readers[i].epoch, 0);
+	store->retired = NULL;
+	return (store);
+}
+
+/**
+ * rb_store_destroy - free a store, its current tree and every node still
+ * waiting to be reclaimed. No reader may hold a snapshot
+ *
+ * @store: store to destroy
+ */
+void rb_store_destroy(rb_store_t *store)
+{
+	rb_retired_t *batch, *next;
+	rb_tree_t **nodes;
+	size_t i;
+
+	if (store == NULL)
+		return;
+	for (batch = store->retired; batch != NULL; batch = next)
+	{
+		next = batch->next;
+		nodes = (rb_tree_t **)(batch + 1);
+		for (i = 0; i < batch->count; i++)
+			free(nodes[i]);
+		free(batch);
+	}
+	rb_tree_delete(atomic_load(&store->root));
+	pthread_mutex_destroy(&store->lock);
+	free(store);
+}
+
+/**
+ * rb_snapshot_acquire - take a snapshot of the tree of a store
+ *
+ * Never blocks. The snapshot stays valid and unchanged until it is
+ * released, whatever the writer does in the meantime. Only follow child
+ * links in a snapshot, parent links are not maintained.
+ *
+ * @store: store to read
+ * @slot: receives the reader slot to release, -1 if all slots are taken
+ *
+ * Return: root of the snapshot, NULL if the tree is empty or on failure
+ */
+rb_tree_t *rb_snapshot_acquire(rb_store_t *store, int *slot)
+{
+	unsigned long idle, epoch;
+	int i;
+
+	for (i = 0; i < RB_STORE_READERS; i++)
+	{
+		idle = 0;
+		epoch = atomic_load(&store->epoch);
+		if (atomic_compare_exchange_strong(&store->readers[i].epoch,
+			&idle, epoch))
+		{
+			/* The root is read after the slot is visible to writers */
+			*slot = i;
+			return (atomic_load(&store->root));
+		}
+	}
+	*slot = -1;
+	return (NULL);
+}
+
+/**
+ * rb_snapshot_release - release a snapshot taken by rb_snapshot_acquire
+ *
+ * @store: store the snapshot was taken from
+ * @slot: reader slot returned by rb_snapshot_acquire
+ */
+void rb_snapshot_release(rb_store_t *store, int slot)
+{
+	if (slot >= 0 && slot < RB_STORE_READERS)
+		atomic_store(&store->readers[slot].epoch, 0);
+}
+
+/**
+ * rb_store_reclaim - free the retired nodes no reader can still reach
+ *
+ * A batch retired in epoch e was unlinked before the epoch moved past e,
+ * so only readers that entered in epoch e or earlier may still see it.
+ *
+ * @store: store to reclaim, with the writer lock held
+ */
+void rb_store_reclaim(rb_store_t *store)
+{
+	rb_retired_t **link, *batch;
+	rb_tree_t **nodes;
+	unsigned long oldest = ULONG_MAX, epoch;
+	size_t i;
+
+	for (i = 0; i < RB_STORE_READERS; i++)
+	{
+		epoch = atomic_load(&store->readers[i].epoch);
+		if (epoch != 0 && epoch < oldest)
+			oldest = epoch;
+	}
+	for (link = &store->retired; *link != NULL;)
+	{
+		batch = *link;
+		if (batch->epoch >= oldest)
+		{
+			link = &batch->next;
+			continue;
+		}
+		*link = batch->next;
+		nodes = (rb_tree_t **)(batch + 1);
+		for (i = 0; i < batch->count; i++)
+			free(nodes[i]);
+		free(batch);
+	}
+}
@@ -0,0 +1,114 @@
+#include "rb_store.h"
+
+/**
+ * rb_store_abort - drop the private nodes of an update that failed or did
+ * not change the tree
+ *
+ * @cow: update to drop
+ */
+static void rb_store_abort(rb_cow_t *cow)
+{
+	size_t i;
+
+	for (i = 0; i < cow->n_fresh; i++)
+		free(cow->fresh[i]);
+}
+
+/**
+ * rb_store_commit - publish the new version built by an update and retire
+ * the nodes it replaced
+ *
+ * @store: store to update, with the writer lock held
+ * @cow: finished update
+ *
+ * Return: 1 on success, -1 on failure
+ */
+static int rb_store_commit(rb_store_t *store, rb_cow_t *cow)
+{
+	rb_retired_t *batch;
+	rb_tree_t **nodes;
+	size_t i;
+
+	batch = malloc(sizeof(*batch) + sizeof(*nodes) * cow->n_retired);
+	if (batch == NULL)
+	{
+		rb_store_abort(cow);
+		return (-1);
+	}
+	for (i = 0; i < cow->n_fresh; i++)
+		RB_SET_PARENT(cow->fresh[i], NULL);
+	nodes = (rb_tree_t **)(batch + 1);
+	for (i = 0; i < cow->n_retired; i++)
+		nodes[i] = cow->retired[i];
+	batch->count = cow->n_retired;
+	atomic_store(&store->root, cow->root);
+	batch->epoch = atomic_load(&store->epoch);
+	batch->next = store->retired;
+	store->retired = batch;
+	atomic_fetch_add(&store->epoch, 1);
+	rb_store_reclaim(store);
+	return (1);
+}
+
+/**
+ * rb_store_update - run one copy-on-write update against a store
+ *
+ * @store: store to update
+ * @n: value to update
+ * @op: update to run, returning 1 if it changed the tree
+ *
+ * Return: 1 if the tree changed, 0 if not, -1 on failure
+ */
+static int rb_store_update(rb_store_t *store, int n,
+	int (*op)(rb_cow_t *cow, int n))
+{
+	rb_cow_t *cow;
+	int ret;
+
+	if (store == NULL)
+		return (-1);
+	/* Kept off the stack so writers can run on small stacks */
+	cow = malloc(sizeof(*cow));
+	if (cow == NULL)
+		return (-1);
+	pthread_mutex_lock(&store->lock);
+	cow->root = atomic_load(&store->root);
+	cow->depth = 0;
+	cow->n_fresh = cow->n_retired = 0;
+	ret = op(cow, n);
+	if (ret == 1)
+		ret = rb_store_commit(store, cow);
+	else
+		rb_store_abort(cow);
+	pthread_mutex_unlock(&store->lock);
+	free(cow);
+	return (ret);
+}
+
+/**
+ * rb_store_insert - insert a value into the tree of a store, publishing a
+ * new version that shares every untouched subtree with the old one
+ *
+ * @store: store to update
+ * @n: value to insert
+ *
+ * Return: 1 if inserted, 0 if already present, -1 on failure
+ */
+int rb_store_insert(rb_store_t *store, int n)
+{
+	return (rb_store_update(store, n, rb_cow_insert));
+}
+
+/**
+ * rb_store_remove - remove a value from the tree of a store, publishing a
+ * new version that shares every untouched subtree with the old one
+ *
+ * @store: store to update
+ * @n: value to remove
+ *
+ * Return: 1 if removed, 0 if not present, -1 on failure
+ */
+int rb_store_remove(rb_store_t *store, int n)
+{
+	return (rb_store_update(store, n, rb_cow_remove));
+}
@@ -1,19 +1,29 @@
 #include "rb_trees.h"
 
-#define IS_RED(node)	(node != NULL && node->color == RED)
-
-void repair_red_violation(
-	rb_tree_t *q, rb_tree_t *p, rb_tree_t *t, rb_tree_t *g, int last);
-
 /**
  * rb_tree_insert - insert a node into an RB tree using a topdown approach
  *
  * @tree: pointer to root node of tree
  * @n: data to insert
  *
- * Return: node inserted
+ * Return: node inserted, or in multiset mode the node holding @n
  */
 rb_tree_t *rb_tree_insert(rb_tree_t **tree, int n)
+{
+	return (rb_tree_insert_arena(NULL, tree, n));
+}
+
+/**
+ * rb_tree_insert_arena - insert a node into an RB tree using a topdown
+ * approach, taking the node from an arena
+ *
+ * @arena: arena to allocate the node from, or NULL to use malloc
+ * @tree: pointer to root node of tree
+ * @n: data to insert
+ *
+ * Return: node inserted, or in multiset mode the node holding @n
+ */
+rb_tree_t *rb_tree_insert_arena(rb_arena_t *arena, rb_tree_t **tree, int n)
 {
 	rb_tree_t *ret, *root;
 
@@ -22,7 +32,7 @@ rb_tree_t *rb_tree_insert(rb_tree_t **tree, int n)
 	if (root == NULL)
 	{
 		/* Empty tree case */
-		root = rb_tree_node(NULL, n, BLACK);
+		root = rb_arena_node(arena, NULL, n, BLACK);
 		*tree = root;
 		ret = root;
 
@@ -34,7 +44,8 @@ rb_tree_t *rb_tree_insert(rb_tree_t **tree, int n)
 
 		rb_tree_t *g, *t;     /* Grandparent & parent */
 		rb_tree_t *p, *q;     /* Iterator & parent */
-		int dir = 0, last;
+		long long key = RB_KEY_OF(n);
+		int dir = 0, last = 0;
 
 		/* Set up helpers */
 		t = &head;
@@ -42,19 +53,21 @@ rb_tree_t *rb_tree_insert(rb_tree_t **tree, int n)
 		q = t->right = root;
 
 		/* Search down the tree */
+		RB_STAT_DESCENT();
 		for (;;)
 		{
+			RB_STAT_STEP();
 			if (q == NULL)
 			{
 				/* Insert new node at the bottom */
 				if (dir)
 				{
-					p->right = q = rb_tree_node(p, n, RED);
+					p->right = q = rb_arena_node(arena, p, n, RED);
 					ret = p->right;
 				}
 				else
 				{
-					p->left = q = rb_tree_node(p, n, RED);
+					p->left = q = rb_arena_node(arena, p, n, RED);
 					ret = p->left;
 				}
 
@@ -64,19 +77,20 @@ rb_tree_t *rb_tree_insert(rb_tree_t **tree, int n)
 			else if (IS_RED(q->left) && IS_RED(q->right))
 			{
 				/* Color flip */
-				q->color = RED;
-				q->left->color = BLACK;
-				q->right->color = BLACK;
+				RB_STAT(color_flips, 1);
+				RB_SET_COLOR(q, RED);
+				RB_SET_COLOR(q->left, BLACK);
+				RB_SET_COLOR(q->right, BLACK);
 			}
 
 			repair_red_violation(q, p, t, g, last);
 
 			/* Stop if found */
-			if (q && q->n == n)
+			if (q && RB_KEY(q) == key)
 				break;
 
 			last = dir;
-			dir = q->n < n;
+			dir = RB_KEY(q) < key;
 
 			/* Update helpers */
 			if (g != NULL)
@@ -91,10 +105,20 @@ rb_tree_t *rb_tree_insert(rb_tree_t **tree, int n)
 
 		/* Update root */
 		*tree = head.right;
+#ifdef RB_MULTISET
+		if (ret == NULL)
+		{
+			/* Already present, count one more occurrence */
+			q->count++;
+			ret = q;
+		}
+#endif
+		if (ret != NULL)
+			RB_AUGMENT_PATH(ret);
 	}
 
 	/* Make root black */
-	root->color = BLACK;
+	RB_SET_COLOR(*tree, BLACK);
 
 	return (ret);
 }
@@ -116,6 +140,7 @@ void repair_red_violation(
 	{
 		int dir2 = t->right == g;
 
+		RB_STAT(red_fixes, 1);
 		if (last)
 		{
 			if (q == p->right)
@@ -169,26 +194,33 @@ rb_tree_t *single_rotate_color_swap(
 {
 	rb_tree_t *tmp;
 
+	RB_STAT(rotations, 1);
 	if (direction)
 	{
 		tmp = root->left;
 		root->left = tmp->right;
 		tmp->right = root;
-		tmp->parent = root->parent;
-		root->parent = tmp;
+		if (root->left != NULL)
+			RB_SET_PARENT(root->left, root);
+		RB_SET_PARENT(tmp, RB_PARENT(root));
+		RB_SET_PARENT(root, tmp);
 	}
 	else
 	{
 		tmp = root->right;
 		root->right = tmp->left;
 		tmp->left = root;
-		tmp->parent = root->parent;
-		root->parent = tmp;
+		if (root->right != NULL)
+			RB_SET_PARENT(root->right, root);
+		RB_SET_PARENT(tmp, RB_PARENT(root));
+		RB_SET_PARENT(root, tmp);
 	}
+	RB_AUGMENT(root);
+	RB_AUGMENT(tmp);
 	if (color_swap)
 	{
-		root->color = RED;
-		tmp->color = BLACK;
+		RB_SET_COLOR(root, RED);
+		RB_SET_COLOR(tmp, BLACK);
 	}
 	return (tmp);
 }
@@ -206,6 +238,7 @@ rb_tree_t *single_rotate_color_swap(
  */
 rb_tree_t *double_rotate(rb_tree_t *root, int direction)
 {
+	RB_STAT(double_rotations, 1);
 	if (direction)
 		root->left = single_rotate_color_swap(
 			root->left, !direction, NO_COLOR_SWAP);
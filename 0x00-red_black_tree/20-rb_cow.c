@@ -0,0 +1,105 @@
+#include "rb_store.h"
+
+rb_tree_t rb_cow_mark;
+
+/**
+ * rb_cow_node - get a private copy of a node for the current update
+ *
+ * @cow: current update
+ * @node: node to copy, returned as is if the update already owns it
+ *
+ * Return: node owned by the update, NULL on failure
+ */
+rb_tree_t *rb_cow_node(rb_cow_t *cow, rb_tree_t *node)
+{
+	rb_tree_t *copy;
+
+	if (RB_PARENT(node) == RB_COW_MARK)
+		return (node);
+	copy = malloc(sizeof(*copy));
+	if (copy == NULL)
+		return (NULL);
+	*copy = *node;
+	RB_SET_PARENT(copy, RB_COW_MARK);
+	cow->fresh[cow->n_fresh++] = copy;
+	cow->retired[cow->n_retired++] = node;
+	return (copy);
+}
+
+/**
+ * rb_cow_child - get a private copy of a child and link it in place
+ *
+ * @cow: current update
+ * @parent: node owned by the update
+ * @dir: which child, 1 for right, 0 for left. It must not be NULL
+ *
+ * Return: child owned by the update, NULL on failure
+ */
+rb_tree_t *rb_cow_child(rb_cow_t *cow, rb_tree_t *parent, int dir)
+{
+	rb_tree_t *child;
+
+	child = rb_cow_node(cow, RB_LINK(parent, dir));
+	if (child != NULL)
+		RB_LINK(parent, dir) = child;
+	return (child);
+}
+
+/**
+ * rb_cow_path - copy every node of the recorded search path
+ *
+ * @cow: current update
+ *
+ * Return: 0 on success, -1 on failure
+ */
+int rb_cow_path(rb_cow_t *cow)
+{
+	rb_tree_t *copy;
+	long i;
+
+	for (i = 0; i < cow->depth; i++)
+	{
+		copy = rb_cow_node(cow, cow->path[i]);
+		if (copy == NULL)
+			return (-1);
+		cow->path[i] = copy;
+		rb_cow_link(cow, i, copy);
+	}
+	return (0);
+}
+
+/**
+ * rb_cow_link - link a node in place of the i-th node of the search path
+ *
+ * @cow: current update
+ * @i: position on the search path, 0 for the root
+ * @node: node to link
+ */
+void rb_cow_link(rb_cow_t *cow, long i, rb_tree_t *node)
+{
+	if (i == 0)
+		cow->root = node;
+	else
+		RB_LINK(cow->path[i - 1], cow->dirs[i - 1]) = node;
+}
+
+/**
+ * rb_cow_rotate - rotate a subtree whose nodes are owned by the update.
+ * Unlike single_rotate_color_swap, no parent link is written, so shared
+ * nodes moving sides are left untouched
+ *
+ * @node: root to rotate
+ * @dir: direction to rotate. 1 is right, 0 is left
+ *
+ * Return: the new root after rotation
+ */
+rb_tree_t *rb_cow_rotate(rb_tree_t *node, int dir)
+{
+	rb_tree_t *top = RB_LINK(node, !dir);
+
+	RB_LINK(node, !dir) = RB_LINK(top, dir);
+	RB_LINK(top, dir) = node;
+	RB_AUGMENT(node);
+	RB_AUGMENT(top);
+	return (top);
+}
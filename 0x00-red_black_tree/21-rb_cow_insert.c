@@ -0,0 +1,123 @@
+#include "rb_store.h"
+
+/**
+ * rb_cow_insert_fixup - restore the RB properties above a new red node,
+ * copying every node that gets recolored or rotated
+ *
+ * @cow: current update, with the path down to @node copied
+ * @node: new node, a child of the last node of the path
+ *
+ * Return: 1 on success, -1 on failure
+ */
+static int rb_cow_insert_fixup(rb_cow_t *cow, rb_tree_t *node)
+{
+	rb_tree_t *p, *g, *u;
+	long i = cow->depth;
+	int dir;
+
+	while (i >= 2 && IS_RED(cow->path[i - 1]))
+	{
+		p = cow->path[i - 1];
+		g = cow->path[i - 2];
+		dir = cow->dirs[i - 2];
+		if (IS_RED(RB_LINK(g, !dir)))
+		{
+			u = rb_cow_child(cow, g, !dir);
+			if (u == NULL)
+				return (-1);
+			RB_SET_COLOR(p, BLACK);
+			RB_SET_COLOR(u, BLACK);
+			RB_SET_COLOR(g, RED);
+			node = g;
+			i -= 2;
+			continue;
+		}
+		if (cow->dirs[i - 1] != dir)
+		{
+			RB_LINK(g, dir) = rb_cow_rotate(p, dir);
+			p = node;
+		}
+		RB_SET_COLOR(p, BLACK);
+		RB_SET_COLOR(g, RED);
+		rb_cow_link(cow, i - 2, rb_cow_rotate(g, !dir));
+		break;
+	}
+	RB_SET_COLOR(cow->root, BLACK);
+	return (1);
+}
+
+/**
+ * rb_cow_count - count one more or one less occurrence of a key that stays
+ * in the tree, in multiset mode
+ *
+ * @cow: current update, with the path down to the parent of @node
+ * @node: node holding the key
+ * @up: 1 to count one more occurrence, 0 for one less
+ *
+ * Return: 1 on success, -1 on failure
+ */
+int rb_cow_count(rb_cow_t *cow, rb_tree_t *node, int up)
+{
+#ifdef RB_MULTISET
+	long i;
+
+	if (cow->depth == RB_COW_DEPTH)
+		return (-1);
+	cow->path[cow->depth++] = node;
+	if (rb_cow_path(cow) == -1)
+		return (-1);
+	node = cow->path[cow->depth - 1];
+	if (up)
+		node->count++;
+	else
+		node->count--;
+	for (i = cow->depth - 1; i >= 0; i--)
+		RB_AUGMENT(cow->path[i]);
+	return (1);
+#else
+	(void)cow;
+	(void)node;
+	(void)up;
+	return (-1);
+#endif
+}
+
+/**
+ * rb_cow_insert - insert a value into a persistent RB tree. Only the
+ * search path and the nodes the repair touches are copied
+ *
+ * @cow: update to run
+ * @n: value to insert
+ *
+ * Return: 1 if inserted, 0 if already present, -1 on failure. In multiset
+ * mode a present value is counted once more and 1 is returned
+ */
+int rb_cow_insert(rb_cow_t *cow, int n)
+{
+	rb_tree_t *cur, *node;
+	long i;
+
+	for (cur = cow->root; cur != NULL; cur = RB_LINK(cur, cur->n < n))
+	{
+		if (cur->n == n)
+#ifdef RB_MULTISET
+			return (rb_cow_count(cow, cur, 1));
+#else
+			return (0);
+#endif
+		if (cow->depth == RB_COW_DEPTH)
+			return (-1);
+		cow->path[cow->depth] = cur;
+		cow->dirs[cow->depth++] = cur->n < n;
+	}
+	if (rb_cow_path(cow) == -1)
+		return (-1);
+	node = rb_tree_node(RB_COW_MARK, n, RED);
+	if (node == NULL)
+		return (-1);
+	cow->fresh[cow->n_fresh++] = node;
+	rb_cow_link(cow, cow->depth, node);
+	for (i = cow->depth - 1; i >= 0; i--)
+		RB_AUGMENT(cow->path[i]);
+	return (rb_cow_insert_fixup(cow, node));
+}
@@ -0,0 +1,161 @@
+#include "rb_store.h"
+
+/**
+ * rb_cow_red_sibling - turn a red sibling black by rotating it above the
+ * parent, which becomes red and moves one step down the path
+ *
+ * @cow: current update
+ * @i: position of the double black node on the path
+ *
+ * Return: new position of the double black node
+ */
+static long rb_cow_red_sibling(rb_cow_t *cow, long i)
+{
+	rb_tree_t *p = cow->path[i - 1];
+	int dir = cow->dirs[i - 1];
+
+	RB_SET_COLOR(RB_LINK(p, !dir), BLACK);
+	RB_SET_COLOR(p, RED);
+	cow->path[i - 1] = rb_cow_rotate(p, dir);
+	rb_cow_link(cow, i - 1, cow->path[i - 1]);
+	cow->path[i] = p;
+	cow->dirs[i] = dir;
+	return (i + 1);
+}
+
+/**
+ * rb_cow_far_red - resolve a double black whose sibling has a red child
+ *
+ * @cow: current update
+ * @i: position of the double black node on the path
+ * @w: sibling, owned by the update
+ *
+ * Return: 1 on success, -1 on failure
+ */
+static int rb_cow_far_red(rb_cow_t *cow, long i, rb_tree_t *w)
+{
+	rb_tree_t *p = cow->path[i - 1], *c;
+	int dir = cow->dirs[i - 1];
+
+	if (!IS_RED(RB_LINK(w, !dir)))
+	{
+		c = rb_cow_child(cow, w, dir);
+		if (c == NULL)
+			return (-1);
+		RB_SET_COLOR(c, BLACK);
+		RB_SET_COLOR(w, RED);
+		w = rb_cow_rotate(w, !dir);
+		RB_LINK(p, !dir) = w;
+	}
+	c = rb_cow_child(cow, w, !dir);
+	if (c == NULL)
+		return (-1);
+	RB_SET_COLOR(w, RB_COLOR(p));
+	RB_SET_COLOR(p, BLACK);
+	RB_SET_COLOR(c, BLACK);
+	rb_cow_link(cow, i - 1, rb_cow_rotate(p, dir));
+	return (1);
+}
+
+/**
+ * rb_cow_remove_fixup - restore the black heights after a black node was
+ * spliced out, copying every node that gets recolored or rotated
+ *
+ * @cow: current update, with the path down to the splice point copied
+ * @x: node that took the place of the spliced node, may be NULL
+ *
+ * Return: 1 on success, -1 on failure
+ */
+int rb_cow_remove_fixup(rb_cow_t *cow, rb_tree_t *x)
+{
+	rb_tree_t *p, *w;
+	long i = cow->depth;
+	int dir;
+
+	while (i > 0 && !IS_RED(x))
+	{
+		if (IS_RED(RB_LINK(cow->path[i - 1], !cow->dirs[i - 1])))
+		{
+			if (rb_cow_child(cow, cow->path[i - 1],
+				!cow->dirs[i - 1]) == NULL)
+				return (-1);
+			i = rb_cow_red_sibling(cow, i);
+		}
+		p = cow->path[i - 1];
+		dir = cow->dirs[i - 1];
+		w = rb_cow_child(cow, p, !dir);
+		if (w == NULL)
+			return (-1);
+		if (IS_RED(w->left) || IS_RED(w->right))
+			return (rb_cow_far_red(cow, i, w));
+		RB_SET_COLOR(w, RED);
+		x = p;
+		i--;
+	}
+	if (x != NULL && IS_RED(x))
+	{
+		x = rb_cow_node(cow, x);
+		if (x == NULL)
+			return (-1);
+		rb_cow_link(cow, i, x);
+		RB_SET_COLOR(x, BLACK);
+	}
+	return (1);
+}
+
+/**
+ * rb_cow_remove - remove a value from a persistent RB tree. Only the
+ * search path and the nodes the repair touches are copied
+ *
+ * @cow: update to run
+ * @n: value to remove
+ *
+ * Return: 1 if removed, 0 if not present, -1 on failure
+ */
+int rb_cow_remove(rb_cow_t *cow, int n)
+{
+	rb_tree_t *cur, *y, *x;
+	long i, z;
+
+	for (cur = cow->root; cur != NULL && cur->n != n;
+		cur = RB_LINK(cur, cur->n < n))
+	{
+		if (cow->depth == RB_COW_DEPTH)
+			return (-1);
+		cow->path[cow->depth] = cur;
+		cow->dirs[cow->depth++] = cur->n < n;
+	}
+	if (cur == NULL)
+		return (0);
+#ifdef RB_MULTISET
+	if (cur->count > 1)
+		return (rb_cow_count(cow, cur, 0));
+#endif
+	if (cow->depth == RB_COW_DEPTH)
+		return (-1);
+	z = cow->depth;
+	cow->path[cow->depth] = cur;
+	cow->dirs[cow->depth++] = 1;
+	/* With two children, the successor is spliced out in its place */
+	if (cur->left != NULL && cur->right != NULL)
+		for (cur = cur->right; cur != NULL; cur = cur->left)
+		{
+			if (cow->depth == RB_COW_DEPTH)
+				return (-1);
+			cow->path[cow->depth] = cur;
+			cow->dirs[cow->depth++] = 0;
+		}
+	y = cow->path[--cow->depth];
+	if (rb_cow_path(cow) == -1)
+		return (-1);
+	cow->retired[cow->n_retired++] = y;
+	if (z < cow->depth)
+		RB_MOVE_KEY(cow->path[z], y);
+	x = y->left != NULL ? y->left : y->right;
+	rb_cow_link(cow, cow->depth, x);
+	for (i = cow->depth - 1; i >= 0; i--)
+		RB_AUGMENT(cow->path[i]);
+	if (RB_COLOR(y) == BLACK)
+		return (rb_cow_remove_fixup(cow, x));
+	return (1);
+}
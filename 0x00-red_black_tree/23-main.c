@@ -0,0 +1,70 @@
+#include <stdlib.h>
+#include "rb_forest.h"
+
+#define WRITERS 4
+#define PER_WRITER 10000
+
+/**
+ * print_node - print the value of a node
+ *
+ * @node: node to print
+ * @data: unused
+ */
+void print_node(const rb_tree_t *node, void *data)
+{
+    (void)data;
+    printf("%d ", node->n);
+}
+
+/**
+ * writer - insert a block of values into the forest
+ *
+ * @arg: forest
+ *
+ * Return: NULL
+ */
+void *writer(void *arg)
+{
+    static int next;
+    static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    int i, first;
+
+    pthread_mutex_lock(&lock);
+    first = next;
+    next += PER_WRITER;
+    pthread_mutex_unlock(&lock);
+    for (i = 0; i < PER_WRITER; i++)
+        rb_forest_insert(arg, first + i);
+    return (NULL);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_forest_t *forest;
+    pthread_t threads[WRITERS];
+    size_t i;
+
+    forest = rb_forest_create(8, 0, 999);
+    if (!forest)
+        return (1);
+    for (i = 0; i < WRITERS; i++)
+        pthread_create(&threads[i], NULL, writer, forest);
+    for (i = 0; i < WRITERS; i++)
+        pthread_join(threads[i], NULL);
+    rb_forest_rebalance(forest);
+    printf("Size: %lu\n", (unsigned long)rb_forest_size(forest));
+    for (i = 0; i < forest->n_shards; i++)
+        printf("Shard %lu: %lu values\n", (unsigned long)i,
+               (unsigned long)forest->shards[i].size);
+    printf("Removed 39995: %d\n", rb_forest_remove(forest, 39995));
+    printf("Find 39995: %d\n", rb_forest_find(forest, 39995));
+    rb_forest_foreach_range(forest, 39990, 40010, print_node, NULL);
+    printf("\n");
+    rb_forest_destroy(forest);
+    return (0);
+}
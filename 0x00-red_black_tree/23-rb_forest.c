@@ -0,0 +1,119 @@
+#include "rb_forest.h"
+
+/**
+ * rb_forest_create - create an empty sharded forest
+ *
+ * The initial boundaries split [@lo, @hi] evenly. Keys outside that range
+ * are still accepted, and the boundaries follow the actual keys as the
+ * forest rebalances.
+ *
+ * @n_shards: number of trees, usually the number of writer threads or more
+ * @lo: smallest key expected
+ * @hi: largest key expected
+ *
+ * Return: pointer to the forest, NULL on failure
+ */
+rb_forest_t *rb_forest_create(size_t n_shards, int lo, int hi)
+{
+	rb_forest_t *forest;
+	size_t i;
+
+	if (n_shards == 0 || lo > hi)
+		return (NULL);
+	forest = calloc(1, sizeof(*forest));
+	if (forest == NULL)
+		return (NULL);
+	forest->shards = calloc(n_shards, sizeof(*forest->shards));
+	forest->bounds = malloc(sizeof(*forest->bounds) * n_shards);
+	if (forest->shards == NULL || forest->bounds == NULL ||
+		pthread_mutex_init(&forest->balance, NULL) != 0)
+	{
+		free(forest->shards);
+		free(forest->bounds);
+		free(forest);
+		return (NULL);
+	}
+	for (i = 0; i < n_shards; i++)
+	{
+		pthread_mutex_init(&forest->shards[i].lock, NULL);
+		atomic_init(&forest->bounds[i], (int)(lo + ((long)hi - lo + 1) *
+			(long)(i + 1) / (long)n_shards));
+	}
+	forest->n_shards = n_shards;
+	forest->every = RB_FOREST_REBALANCE / n_shards ?
+		RB_FOREST_REBALANCE / n_shards : 1;
+	return (forest);
+}
+
+/**
+ * rb_forest_destroy - free a forest and all of its trees
+ *
+ * @forest: forest to destroy, with no operation in progress
+ */
+void rb_forest_destroy(rb_forest_t *forest)
+{
+	size_t i;
+
+	if (forest == NULL)
+		return;
+	for (i = 0; i < forest->n_shards; i++)
+	{
+		rb_tree_delete(forest->shards[i].root);
+		pthread_mutex_destroy(&forest->shards[i].lock);
+	}
+	pthread_mutex_destroy(&forest->balance);
+	free(forest->shards);
+	free(forest->bounds);
+	free(forest);
+}
+
+/**
+ * rb_forest_route - find the shard a key belongs to. Without the shard
+ * locks held, boundaries may move and the answer be stale
+ *
+ * @forest: forest
+ * @n: key to route
+ *
+ * Return: index of the shard
+ */
+size_t rb_forest_route(const rb_forest_t *forest, int n)
+{
+	size_t lo = 0, hi = forest->n_shards - 1, mid;
+
+	/* First shard whose upper bound is above @n */
+	while (lo < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+		if (atomic_load_explicit(&forest->bounds[mid],
+			memory_order_relaxed) > n)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	return (lo);
+}
+
+/**
+ * rb_forest_updated - check the balance of the shards, called every
+ * @every updates of a shard. Shard sizes and update counts are summed,
+ * and every RB_FOREST_REBALANCE updates overall the shard boundaries are
+ * moved if the shards are out of balance
+ *
+ * @forest: forest, with no lock held
+ */
+void rb_forest_updated(rb_forest_t *forest)
+{
+	size_t total, updates, largest;
+
+	/* Another thread is checking or moving the boundaries already */
+	if (pthread_mutex_trylock(&forest->balance) != 0)
+		return;
+	total = rb_forest_count(forest, &updates, &largest);
+	if (updates - forest->checked >= RB_FOREST_REBALANCE)
+	{
+		forest->checked = updates;
+		if (largest > 2 * (total / forest->n_shards) + RB_FOREST_SLACK)
+			rb_forest_spread(forest);
+	}
+	pthread_mutex_unlock(&forest->balance);
+}
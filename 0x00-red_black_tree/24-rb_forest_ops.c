@@ -0,0 +1,141 @@
+#include "rb_forest.h"
+
+/**
+ * rb_forest_insert - insert a value into a forest. Writers to different
+ * shards proceed in parallel
+ *
+ * @forest: forest to update
+ * @n: value to insert
+ *
+ * Return: 1 if inserted, 0 if already present or on failure
+ */
+int rb_forest_insert(rb_forest_t *forest, int n)
+{
+	rb_shard_t *shard;
+	int inserted, check;
+
+	if (forest == NULL)
+		return (0);
+	shard = rb_forest_lock(forest, n, NULL);
+	inserted = rb_tree_insert(&shard->root, n) != NULL;
+	shard->size += inserted;
+	shard->updates += inserted;
+	check = inserted && shard->updates % forest->every == 0;
+	pthread_mutex_unlock(&shard->lock);
+	if (check)
+		rb_forest_updated(forest);
+	return (inserted);
+}
+
+/**
+ * rb_forest_remove - remove a value from a forest
+ *
+ * @forest: forest to update
+ * @n: value to remove
+ *
+ * Return: 1 if removed, 0 if not present
+ */
+int rb_forest_remove(rb_forest_t *forest, int n)
+{
+	rb_shard_t *shard;
+	int removed, check;
+
+	if (forest == NULL)
+		return (0);
+	shard = rb_forest_lock(forest, n, NULL);
+	removed = rb_tree_find(shard->root, n) != NULL;
+	if (removed)
+	{
+		shard->root = rb_tree_remove(shard->root, n);
+		shard->size--;
+		shard->updates++;
+	}
+	check = removed && shard->updates % forest->every == 0;
+	pthread_mutex_unlock(&shard->lock);
+	if (check)
+		rb_forest_updated(forest);
+	return (removed);
+}
+
+/**
+ * rb_forest_find - look a value up in a forest. Nodes are not returned,
+ * as another thread may free them as soon as the shard is unlocked
+ *
+ * @forest: forest to search
+ * @n: value to search for
+ *
+ * Return: 1 if present, 0 if not
+ */
+int rb_forest_find(rb_forest_t *forest, int n)
+{
+	rb_shard_t *shard;
+	int found;
+
+	if (forest == NULL)
+		return (0);
+	shard = rb_forest_lock(forest, n, NULL);
+	found = rb_tree_find(shard->root, n) != NULL;
+	pthread_mutex_unlock(&shard->lock);
+	return (found);
+}
+
+/**
+ * rb_forest_foreach_range - call a function on every node of a forest in
+ * a closed range, in ascending order
+ *
+ * Each shard the range covers is locked in turn while it is visited, up
+ * to its upper bound, and the next shard is the one holding that bound.
+ * Boundaries moving in between can't make a key visited twice or missed.
+ * @action must not call back into the forest.
+ *
+ * @forest: forest to visit
+ * @lo: lower bound of the range
+ * @hi: upper bound of the range
+ * @action: function called on each node in the range
+ * @data: argument passed through to @action
+ *
+ * Return: number of nodes visited
+ */
+size_t rb_forest_foreach_range(rb_forest_t *forest, int lo, int hi,
+	void (*action)(const rb_tree_t *node, void *data), void *data)
+{
+	rb_shard_t *shard;
+	size_t i, count = 0;
+	long long next, end;
+
+	if (forest == NULL || action == NULL || lo > hi)
+		return (0);
+	for (next = lo; next <= hi; next = end + 1)
+	{
+		shard = rb_forest_lock(forest, (int)next, &i);
+		end = hi;
+		if (i + 1 < forest->n_shards && atomic_load_explicit(
+			&forest->bounds[i], memory_order_relaxed) <= hi)
+			end = atomic_load_explicit(&forest->bounds[i],
+				memory_order_relaxed) - 1;
+		count += rb_tree_foreach_range(shard->root, (int)next, (int)end,
+			action, data);
+		pthread_mutex_unlock(&shard->lock);
+	}
+	return (count);
+}
+
+/**
+ * rb_forest_size - count the values of a forest
+ *
+ * @forest: forest to measure
+ *
+ * Return: number of values
+ */
+size_t rb_forest_size(rb_forest_t *forest)
+{
+	size_t size;
+
+	if (forest == NULL)
+		return (0);
+	/* No keys move between shards while they are counted */
+	pthread_mutex_lock(&forest->balance);
+	size = rb_forest_count(forest, NULL, NULL);
+	pthread_mutex_unlock(&forest->balance);
+	return (size);
+}
@@ -0,0 +1,160 @@
+#include "rb_forest.h"
+
+/**
+ * rb_forest_nth - find the node holding the k-th smallest key of a tree
+ *
+ * @tree: root of the tree
+ * @k: index of the key in sorted order, smaller than the size of @tree
+ * @below: receives the number of keys in the nodes before the one found,
+ * which is @k unless multiset counts put @k inside the node
+ *
+ * Return: node holding the key
+ */
+static rb_tree_t *rb_forest_nth(rb_tree_t *tree, size_t k, size_t *below)
+{
+	rb_tree_t *node;
+
+#ifdef RB_ORDER_STAT
+	node = rb_tree_select(tree, k);
+	*below = rb_tree_rank(tree, node->n);
+#else
+	/* Costs O(k), about the number of keys about to change shards */
+	for (node = tree; node->left != NULL; node = node->left)
+		;
+	for (*below = 0; *below + RB_COUNT(node) <= k;
+		node = rb_tree_next(node))
+		*below += RB_COUNT(node);
+#endif
+	return (node);
+}
+
+/**
+ * rb_forest_push - move the largest keys of a shard to the next shard
+ * until the shards before the next one hold a target number of keys
+ *
+ * @forest: forest, with the balance lock held
+ * @i: shard to move keys from
+ * @rank: number of keys in the shards before @i, updated to include
+ * shard @i once its keys are moved
+ * @target: number of keys the shards up to @i should hold
+ */
+static void rb_forest_push(rb_forest_t *forest, size_t i, size_t *rank,
+	size_t target)
+{
+	rb_shard_t *from = &forest->shards[i], *to = &forest->shards[i + 1];
+	rb_tree_t *pivot, *hi;
+	size_t below, k;
+
+	pthread_mutex_lock(&from->lock);
+	pthread_mutex_lock(&to->lock);
+	*rank += from->size;
+	k = *rank > target ? *rank - target : 0;
+	if (k > from->size)
+		k = from->size;
+	if (k > 0)
+	{
+		pivot = rb_forest_nth(from->root, from->size - k, &below);
+		k = from->size - below;
+		atomic_store_explicit(&forest->bounds[i], pivot->n,
+			memory_order_relaxed);
+		pivot = rb_tree_split(from->root, pivot->n, &from->root, &hi);
+		to->root = rb_tree_concat(rb_tree_join(NULL, pivot, hi),
+			to->root);
+		from->size -= k;
+		to->size += k;
+		*rank -= k;
+	}
+	pthread_mutex_unlock(&to->lock);
+	pthread_mutex_unlock(&from->lock);
+}
+
+/**
+ * rb_forest_pull - move the smallest keys of the next shard to a shard
+ * until the shards up to the next one hold a target number of keys
+ *
+ * @forest: forest, with the balance lock held
+ * @i: shard to move keys to
+ * @rank: number of keys in the shards up to @i + 1, updated to exclude
+ * shard @i + 1 once its keys are moved
+ * @target: number of keys the shards up to @i should hold
+ */
+static void rb_forest_pull(rb_forest_t *forest, size_t i, size_t *rank,
+	size_t target)
+{
+	rb_shard_t *to = &forest->shards[i], *from = &forest->shards[i + 1];
+	rb_tree_t *pivot, *lo;
+	size_t k;
+
+	pthread_mutex_lock(&to->lock);
+	pthread_mutex_lock(&from->lock);
+	*rank -= *rank > from->size ? from->size : *rank;
+	k = *rank < target ? target - *rank : 0;
+	/* The last shard holds the keys above every bound, keep one there */
+	if (i + 2 == forest->n_shards && k >= from->size)
+		k = from->size ? from->size - 1 : 0;
+	if (k > 0 && k >= from->size)
+	{
+		/* Shard i + 1 is left empty, its range shrinks to nothing */
+		k = from->size;
+		atomic_store_explicit(&forest->bounds[i], atomic_load_explicit(
+			&forest->bounds[i + 1], memory_order_relaxed),
+			memory_order_relaxed);
+		to->root = rb_tree_concat(to->root, from->root);
+		from->root = NULL;
+	}
+	else if (k > 0)
+	{
+		pivot = rb_forest_nth(from->root, k, &k);
+		atomic_store_explicit(&forest->bounds[i], pivot->n,
+			memory_order_relaxed);
+		pivot = rb_tree_split(from->root, pivot->n, &lo, &from->root);
+		from->root = rb_tree_join(NULL, pivot, from->root);
+		to->root = rb_tree_concat(to->root, lo);
+	}
+	from->size -= k;
+	to->size += k;
+	*rank += k;
+	pthread_mutex_unlock(&from->lock);
+	pthread_mutex_unlock(&to->lock);
+}
+
+/**
+ * rb_forest_spread - move the shard boundaries so that every shard holds
+ * about the same number of keys
+ *
+ * Boundary i should sit at global rank target(i) = (i + 1) * total / N.
+ * Boundaries moving down are settled from the first one up and boundaries
+ * moving up from the last one down, so a shard always holds the keys it
+ * has to hand over. Keys change shards with one split and one join each,
+ * O(N log(n)) overall. Each move locks the two shards involved only, so
+ * operations on the other shards go on, and the targets drift by as many
+ * keys as they update meanwhile.
+ *
+ * @forest: forest, with the balance lock held
+ */
+void rb_forest_spread(rb_forest_t *forest)
+{
+	size_t i, total, rank, n = forest->n_shards;
+
+	total = rb_forest_count(forest, NULL, NULL);
+	for (i = 0, rank = 0; i + 1 < n; i++)
+		rb_forest_push(forest, i, &rank, (i + 1) * total / n);
+	total = rb_forest_count(forest, NULL, NULL);
+	for (i = n - 1, rank = total; i > 0; i--)
+		rb_forest_pull(forest, i - 1, &rank, i * total / n);
+}
+
+/**
+ * rb_forest_rebalance - move the shard boundaries so that every shard
+ * holds about the same number of keys
+ *
+ * @forest: forest to rebalance
+ */
+void rb_forest_rebalance(rb_forest_t *forest)
+{
+	if (forest == NULL)
+		return;
+	pthread_mutex_lock(&forest->balance);
+	rb_forest_spread(forest);
+	pthread_mutex_unlock(&forest->balance);
+}
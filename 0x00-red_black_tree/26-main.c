@@ -0,0 +1,56 @@
+#include <stdlib.h>
+#include <string.h>
+#include "rb_generic.h"
+
+/**
+ * struct point_s - Payload stored in the nodes
+ *
+ * @x: Abscissa
+ * @y: Ordinate
+ */
+typedef struct point_s
+{
+    double x;
+    double y;
+} point_t;
+
+RB_GENERATE(points, long, point_t, RB_CMP_NUM)
+RB_GENERATE(names, const char *, int, strcmp)
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    points_t points;
+    points_node_t *p;
+    names_t names;
+    names_node_t *name;
+    const char *words[] = { "red", "black", "tree", "node", "root" };
+    long i;
+
+    points_init(&points);
+    for (i = 0; i < 10; i++)
+    {
+        point_t point = { i * 1.5, i * 2.0 };
+
+        points_insert(&points, i * 10000000000L, point);
+    }
+    points_remove(&points, 30000000000L);
+    for (p = points_first(&points); p; p = points_next(p))
+        printf("%ld: (%.1f, %.1f)\n", p->key, p->value.x, p->value.y);
+    points_clear(&points);
+
+    names_init(&names);
+    for (i = 0; i < 5; i++)
+        names_insert(&names, words[i], (int)strlen(words[i]));
+    name = names_find(&names, "tree");
+    printf("tree: %d\n", name ? name->value : -1);
+    for (name = names_lower_bound(&names, "o"); name; name = names_next(name))
+        printf("%s ", name->key);
+    printf("\nSize: %lu\n", (unsigned long)names.size);
+    names_clear(&names);
+    return (0);
+}
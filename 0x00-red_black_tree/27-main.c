@@ -0,0 +1,45 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+/**
+ * print_counts - print each key of a tree with its number of occurrences
+ *
+ * @tree: root of the tree
+ */
+void print_counts(const rb_tree_t *tree)
+{
+    if (!tree)
+        return;
+    print_counts(tree->left);
+    printf("%d x%lu\n", tree->n, (unsigned long)tree->count);
+    print_counts(tree->right);
+}
+
+/**
+ * main - Entry point, build with -DRB_MULTISET
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree;
+    int array[] = {
+        7, 3, 7, 7, 1, 3, 9, 7, 1, 3,
+        3, 3, 9, 7, 5, 7
+    };
+    size_t n = sizeof(array) / sizeof(array[0]);
+
+    tree = array_to_rb_tree(array, n);
+    if (!tree)
+        return (1);
+    print_counts(tree);
+    rb_tree_insert(&tree, 5);
+    tree = rb_tree_remove(tree, 7);
+    tree = rb_tree_remove(tree, 9);
+    tree = rb_tree_remove(tree, 9);
+    printf("Inserted 5, removed 7 once and 9 twice\n");
+    print_counts(tree);
+    printf("Is valid: %d\n", rb_tree_is_valid(tree));
+    rb_tree_delete(tree);
+    return (0);
+}
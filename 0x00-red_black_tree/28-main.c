@@ -0,0 +1,50 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+/**
+ * print_interval - print an interval
+ *
+ * @node: node holding the interval
+ * @data: unused
+ */
+void print_interval(const rb_tree_t *node, void *data)
+{
+    (void)data;
+    printf("[%d, %d] ", node->n, node->hi);
+}
+
+/**
+ * main - Entry point, build with -DRB_INTERVAL
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree = NULL;
+    int spans[][2] = {
+        {15, 20}, {10, 30}, {17, 19}, {5, 20}, {12, 15}, {30, 40},
+        {1, 3}, {42, 50}, {25, 26}, {8, 9}, {10, 11}
+    };
+    size_t n = sizeof(spans) / sizeof(spans[0]);
+    size_t i, k;
+
+    for (i = 0; i < n; i++)
+        rb_tree_insert_interval(&tree, spans[i][0], spans[i][1]);
+    printf("Is valid: %d\n", rb_tree_is_valid(tree));
+    k = rb_tree_foreach_overlap(tree, 18, 27, print_interval, NULL);
+    printf("\n%lu intervals overlap [18, 27]\n", (unsigned long)k);
+    k = rb_tree_stab(tree, 12, print_interval, NULL);
+    printf("\n%lu intervals contain 12\n", (unsigned long)k);
+    tree = rb_tree_remove_interval(tree, 10, 30);
+    k = rb_tree_stab(tree, 12, print_interval, NULL);
+    printf("\n%lu intervals contain 12 after removing [10, 30]\n",
+           (unsigned long)k);
+    k = rb_tree_stab(tree, 11, print_interval, NULL);
+    printf("\n%lu intervals contain 11\n", (unsigned long)k);
+    printf("Overlaps [31, 41]: %s\n",
+           rb_tree_overlap_any(tree, 31, 41) ? "yes" : "no");
+    printf("Overlaps [51, 60]: %s\n",
+           rb_tree_overlap_any(tree, 51, 60) ? "yes" : "no");
+    rb_tree_delete(tree);
+    return (0);
+}
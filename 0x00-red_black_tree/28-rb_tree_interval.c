@@ -0,0 +1,143 @@
+#include "rb_trees.h"
+
+#ifdef RB_INTERVAL
+/**
+ * rb_tree_insert_interval - insert an interval into an interval tree
+ *
+ * Intervals are ordered by low endpoint, then by high endpoint, so several
+ * intervals may start at the same value but each is stored once. The node
+ * is linked at the bottom and the tree repaired on the way back up.
+ *
+ * @tree: pointer to root node of tree
+ * @lo: low endpoint
+ * @hi: high endpoint, at least @lo
+ *
+ * Return: node inserted, NULL if the tree holds [@lo, @hi] already or on
+ * failure
+ */
+rb_tree_t *rb_tree_insert_interval(rb_tree_t **tree, int lo, int hi)
+{
+	rb_tree_t *node, *parent = NULL;
+	long long key = RB_PAIR_KEY(lo, hi);
+	int dir = 0;
+
+	if (tree == NULL || hi < lo)
+		return (NULL);
+	for (node = *tree; node != NULL; node = RB_LINK(node, dir))
+	{
+		if (RB_KEY(node) == key)
+			return (NULL);
+		parent = node;
+		dir = RB_KEY(node) < key;
+	}
+	node = rb_tree_node(parent, lo, RED);
+	if (node == NULL)
+		return (NULL);
+	node->hi = hi;
+	if (parent == NULL)
+		*tree = node;
+	else
+		RB_LINK(parent, dir) = node;
+	RB_AUGMENT_PATH(node);
+	rb_insert_fixup(tree, node);
+	return (node);
+}
+
+/**
+ * rb_tree_overlap_any - find one interval overlapping a closed range
+ *
+ * When the left subtree reaches @lo it holds an overlap if any interval
+ * does, so a single path is followed, in O(log(n)).
+ *
+ * @tree: root of the tree
+ * @lo: low end of the range
+ * @hi: high end of the range
+ *
+ * Return: an overlapping interval, NULL if there is none
+ */
+rb_tree_t *rb_tree_overlap_any(rb_tree_t *tree, int lo, int hi)
+{
+	while (tree != NULL)
+	{
+		if (tree->n <= hi && tree->hi >= lo)
+			return (tree);
+		if (tree->left != NULL && tree->left->max >= lo)
+			tree = tree->left;
+		else
+			tree = tree->right;
+	}
+	return (NULL);
+}
+
+/**
+ * rb_overlap_r - visit the overlapping intervals of a subtree in order
+ *
+ * @tree: root of the subtree
+ * @lo: low end of the range
+ * @hi: high end of the range
+ * @action: function called on each overlapping interval
+ * @data: argument passed through to @action
+ *
+ * Return: number of intervals visited
+ */
+static size_t rb_overlap_r(rb_tree_t *tree, int lo, int hi,
+	void (*action)(const rb_tree_t *node, void *data), void *data)
+{
+	size_t count = 0;
+
+	/* Nothing below ends at @lo or later */
+	if (tree == NULL || tree->max < lo)
+		return (0);
+	count += rb_overlap_r(tree->left, lo, hi, action, data);
+	/* Everything to the right starts after @hi */
+	if (tree->n > hi)
+		return (count);
+	if (tree->hi >= lo)
+	{
+		action(tree, data);
+		count++;
+	}
+	return (count + rb_overlap_r(tree->right, lo, hi, action, data));
+}
+
+/**
+ * rb_tree_foreach_overlap - call a function on every interval overlapping
+ * a closed range, by increasing low endpoint
+ *
+ * Subtrees ending before @lo or starting after @hi are skipped, so every
+ * subtree entered either holds an overlap or lies on the search path for
+ * @hi: O(log(n) + k) when the k overlaps are clustered, and at worst
+ * O(log(n) + k * log(n / k)).
+ *
+ * @tree: root of the tree
+ * @lo: low end of the range
+ * @hi: high end of the range
+ * @action: function called on each overlapping interval
+ * @data: argument passed through to @action
+ *
+ * Return: number of intervals visited
+ */
+size_t rb_tree_foreach_overlap(rb_tree_t *tree, int lo, int hi,
+	void (*action)(const rb_tree_t *node, void *data), void *data)
+{
+	if (action == NULL || lo > hi)
+		return (0);
+	return (rb_overlap_r(tree, lo, hi, action, data));
+}
+
+/**
+ * rb_tree_stab - call a function on every interval containing a point
+ *
+ * @tree: root of the tree
+ * @x: point
+ * @action: function called on each interval containing @x
+ * @data: argument passed through to @action
+ *
+ * Return: number of intervals visited
+ */
+size_t rb_tree_stab(rb_tree_t *tree, int x,
+	void (*action)(const rb_tree_t *node, void *data), void *data)
+{
+	return (rb_tree_foreach_overlap(tree, x, x, action, data));
+}
+#endif /* RB_INTERVAL */
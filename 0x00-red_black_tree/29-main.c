@@ -0,0 +1,43 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+void rb_tree_print(const rb_tree_t *tree);
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree;
+    rb_frozen_t *frozen;
+    const int *key;
+    int array[] = {
+        79, 47, 68, 87, 84, 91, 21, 32, 34, 2,
+        20, 22, 98, 1, 62, 95
+    };
+    size_t n = sizeof(array) / sizeof(array[0]);
+    size_t i;
+
+    tree = array_to_rb_tree(array, n);
+    if (!tree)
+        return (1);
+    frozen = rb_tree_freeze(tree);
+    rb_tree_delete(tree);
+    if (!frozen)
+        return (1);
+    printf("Eytzinger order:");
+    for (i = 1; i <= frozen->size; i++)
+        printf(" %d", frozen->keys[i]);
+    printf("\nFind 84: %d\n", rb_frozen_find(frozen, 84));
+    printf("Find 85: %d\n", rb_frozen_find(frozen, 85));
+    key = rb_frozen_lower_bound(frozen, 85);
+    printf("Lower bound of 85: %d\n", key ? *key : -1);
+    tree = rb_tree_thaw(frozen);
+    rb_frozen_free(frozen);
+    rb_tree_print(tree);
+    printf("Is valid: %d\n", rb_tree_is_valid(tree));
+    rb_tree_delete(tree);
+    return (0);
+}
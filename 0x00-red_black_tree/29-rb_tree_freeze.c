@@ -0,0 +1,130 @@
+#include "rb_trees.h"
+
+/**
+ * rb_keys - copy the keys of an RB tree in order
+ *
+ * Only child links are followed, so snapshots of a store can be frozen.
+ *
+ * @tree: root of the tree
+ * @out: receives the keys, or NULL to only count them
+ *
+ * Return: number of keys
+ */
+static size_t rb_keys(const rb_tree_t *tree, int *out)
+{
+	size_t left;
+
+	if (tree == NULL)
+		return (0);
+	left = rb_keys(tree->left, out);
+	if (out != NULL)
+		out[left] = tree->n;
+	return (left + 1 + rb_keys(tree->right,
+		out != NULL ? out + left + 1 : NULL));
+}
+
+/**
+ * rb_eytzinger - convert between sorted and Eytzinger order, by walking
+ * the implicit tree of the Eytzinger array in order
+ *
+ * @eytz: keys in Eytzinger order, indexed from 1
+ * @sorted: keys in sorted order
+ * @size: number of keys
+ * @k: index of the current node of the implicit tree
+ * @i: index of the next key in @sorted
+ * @fill: 1 to fill @eytz from @sorted, 0 to fill @sorted from @eytz
+ */
+static void rb_eytzinger(int *eytz, int *sorted, size_t size, size_t k,
+	size_t *i, int fill)
+{
+	if (k > size)
+		return;
+	rb_eytzinger(eytz, sorted, size, 2 * k, i, fill);
+	if (fill)
+		eytz[k] = sorted[(*i)++];
+	else
+		sorted[(*i)++] = eytz[k];
+	rb_eytzinger(eytz, sorted, size, 2 * k + 1, i, fill);
+}
+
+/**
+ * rb_tree_freeze - copy the keys of an RB tree into a read-only array
+ * searched without pointer chasing
+ *
+ * In Eytzinger order the nodes near the root share cache lines and the
+ * children of a node sit next to each other, so a lookup touches about
+ * one new cache line every four levels and its next lines can be
+ * prefetched. Multiset counts and interval endpoints are not kept.
+ *
+ * @tree: root of the tree, left unchanged
+ *
+ * Return: frozen copy of the keys, NULL on failure
+ */
+rb_frozen_t *rb_tree_freeze(const rb_tree_t *tree)
+{
+	rb_frozen_t *frozen;
+	size_t size, bytes, i = 0;
+	int *sorted;
+
+	frozen = malloc(sizeof(*frozen));
+	if (frozen == NULL)
+		return (NULL);
+	size = rb_keys(tree, NULL);
+	bytes = sizeof(int) * (size + 1);
+	bytes = (bytes + RB_CACHE_LINE - 1) / RB_CACHE_LINE * RB_CACHE_LINE;
+	frozen->keys = aligned_alloc(RB_CACHE_LINE, bytes);
+	sorted = malloc(sizeof(*sorted) * (size + 1));
+	if (frozen->keys == NULL || sorted == NULL)
+	{
+		free(frozen->keys);
+		free(sorted);
+		free(frozen);
+		return (NULL);
+	}
+	frozen->size = size;
+	frozen->map = NULL;
+	frozen->keys[0] = 0;
+	rb_keys(tree, sorted);
+	rb_eytzinger(frozen->keys, sorted, size, 1, &i, 1);
+	free(sorted);
+	return (frozen);
+}
+
+/**
+ * rb_tree_thaw - rebuild a mutable RB tree from a frozen array, in linear
+ * time
+ *
+ * @frozen: frozen array, left unchanged
+ *
+ * Return: root of the new tree, NULL if it is empty or on failure
+ */
+rb_tree_t *rb_tree_thaw(const rb_frozen_t *frozen)
+{
+	return (rb_tree_thaw_arena(NULL, frozen));
+}
+
+/**
+ * rb_tree_thaw_arena - rebuild a mutable RB tree from a frozen array, in
+ * linear time, taking the nodes from an arena
+ *
+ * @arena: arena to allocate nodes from, or NULL to use malloc
+ * @frozen: frozen array, left unchanged
+ *
+ * Return: root of the new tree, NULL if it is empty or on failure
+ */
+rb_tree_t *rb_tree_thaw_arena(rb_arena_t *arena, const rb_frozen_t *frozen)
+{
+	rb_tree_t *root;
+	size_t i = 0;
+	int *sorted;
+
+	if (frozen == NULL || frozen->size == 0)
+		return (NULL);
+	sorted = malloc(sizeof(*sorted) * frozen->size);
+	if (sorted == NULL)
+		return (NULL);
+	rb_eytzinger(frozen->keys, sorted, frozen->size, 1, &i, 0);
+	root = sorted_array_to_rb_tree_arena(arena, sorted, frozen->size);
+	free(sorted);
+	return (root);
+}
@@ -1,8 +1,59 @@
 #include "rb_trees.h"
 
+/**
+ * sorted_order - classify the ordering of an array
+ *
+ * @array: array to check
+ * @size: size of array
+ *
+ * Return: 2 if strictly ascending, 1 if ascending with duplicates,
+ * 0 if unsorted
+ */
+static int sorted_order(const int *array, size_t size)
+{
+	size_t i;
+	int order = 2;
+
+	for (i = 1; i < size; i++)
+	{
+		if (array[i - 1] > array[i])
+			return (0);
+		if (array[i - 1] == array[i])
+			order = 1;
+	}
+	return (order);
+}
+
+#ifdef RB_MULTISET
+/**
+ * rb_set_counts - store the occurrence counts of the keys of a freshly
+ * built tree, in order, and recompute the augmented fields
+ *
+ * @node: root of the subtree
+ * @runs: counts of the keys of the subtree, in order
+ *
+ * Return: pointer past the last count used
+ */
+const size_t *rb_set_counts(rb_tree_t *node, const size_t *runs)
+{
+	if (node == NULL)
+		return (runs);
+	runs = rb_set_counts(node->left, runs);
+	node->count = *runs++;
+	runs = rb_set_counts(node->right, runs);
+	RB_AUGMENT(node);
+	return (runs);
+}
+#endif
+
 /**
  * array_to_rb_tree - convert an array to an RB-tree
  *
+ * Strictly ascending input is built directly in linear time. Anything else
+ * is copied, sorted if needed and stripped of duplicates first, which gives
+ * the same set of keys as inserting each element one at a time. In
+ * multiset mode the duplicates are counted in their key's node.
+ *
  * @array: array to convert
  * @size: size of array
  *
@@ -10,14 +61,67 @@
  */
 rb_tree_t *array_to_rb_tree(int *array, size_t size)
 {
-	size_t i;
+	return (array_to_rb_tree_arena(NULL, array, size));
+}
+
+/**
+ * array_to_rb_tree_arena - convert an array to an RB-tree whose nodes are
+ * taken from an arena
+ *
+ * @arena: arena to allocate nodes from, or NULL to use malloc
+ * @array: array to convert
+ * @size: size of array
+ *
+ * Return: root node of RB-tree
+ */
+rb_tree_t *array_to_rb_tree_arena(rb_arena_t *arena, int *array, size_t size)
+{
+	size_t i, unique, *runs = NULL;
+	int *keys, order;
 	rb_tree_t *root;
 
-	root = NULL;
-	if (array == NULL)
-		return (root);
+	if (array == NULL || size == 0)
+		return (NULL);
+	order = sorted_order(array, size);
+	if (order == 2)
+		return (sorted_array_to_rb_tree_arena(arena, array, size));
+	keys = malloc(sizeof(*keys) * size);
+#ifdef RB_MULTISET
+	runs = malloc(sizeof(*runs) * size);
+	if (runs == NULL)
+	{
+		free(keys);
+		return (NULL);
+	}
+	runs[0] = 1;
+#endif
+	if (keys == NULL)
+	{
+		free(runs);
+		return (NULL);
+	}
 	for (i = 0; i < size; i++)
-		rb_tree_insert(&root, array[i]);
+		keys[i] = array[i];
+	if (order == 0)
+		rb_sort_keys(keys, size);
+	/* Drop duplicates, insert keeps only the first occurrence */
+	for (i = 1, unique = 1; i < size; i++)
+	{
+		if (keys[i] != keys[unique - 1])
+		{
+			if (runs != NULL)
+				runs[unique] = 0;
+			keys[unique++] = keys[i];
+		}
+		if (runs != NULL)
+			runs[unique - 1]++;
+	}
+	root = sorted_array_to_rb_tree_arena(arena, keys, unique);
+#ifdef RB_MULTISET
+	rb_set_counts(root, runs);
+#endif
+	free(keys);
+	free(runs);
 
 	return (root);
 }
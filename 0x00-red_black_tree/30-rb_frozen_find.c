@@ -0,0 +1,52 @@
+#include "rb_trees.h"
+
+/**
+ * rb_frozen_lower_bound - find the smallest key of a frozen array that is
+ * not smaller than a value
+ *
+ * The descent has no data-dependent branch: each level picks the child
+ * with the result of the comparison, and the nodes four levels below are
+ * prefetched, one cache line for all 16 of them. The last step to the
+ * right marks the answer, found by stripping the trailing right steps.
+ *
+ * @frozen: frozen array
+ * @n: value to seek to
+ *
+ * Return: pointer to the key, NULL if every key is smaller than @n
+ */
+const int *rb_frozen_lower_bound(const rb_frozen_t *frozen, int n)
+{
+	size_t k = 1;
+
+	if (frozen == NULL)
+		return (NULL);
+	while (k <= frozen->size)
+	{
+		RB_PREFETCH(frozen->keys + 16 * k);
+		k = 2 * k + (frozen->keys[k] < n);
+	}
+	/* Drop the trailing 1 bits, then the 0 bit of the last left step */
+#ifdef __GNUC__
+	k >>= __builtin_ctzll(~(unsigned long long)k) + 1;
+#else
+	while (k & 1)
+		k >>= 1;
+	k >>= 1;
+#endif
+	return (k == 0 ? NULL : frozen->keys + k);
+}
+
+/**
+ * rb_frozen_find - look a value up in a frozen array
+ *
+ * @frozen: frozen array
+ * @n: value to search for
+ *
+ * Return: 1 if present, 0 if not
+ */
+int rb_frozen_find(const rb_frozen_t *frozen, int n)
+{
+	const int *key = rb_frozen_lower_bound(frozen, n);
+
+	return (key != NULL && *key == n);
+}
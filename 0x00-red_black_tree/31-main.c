@@ -0,0 +1,44 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+void rb_tree_print(const rb_tree_t *tree);
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree;
+    rb_frozen_t *index;
+    rb_arena_t *arena;
+    int array[] = {
+        79, 47, 68, 87, 84, 91, 21, 32, 34, 2,
+        20, 22, 98, 1, 62, 95
+    };
+    size_t n = sizeof(array) / sizeof(array[0]);
+
+    tree = array_to_rb_tree(array, n);
+    if (!tree)
+        return (1);
+    if (rb_tree_save(tree, "31-tree.rbt") == -1)
+        return (1);
+    rb_tree_delete(tree);
+
+    index = rb_frozen_map("31-tree.rbt");
+    if (!index)
+        return (1);
+    printf("Mapped %lu keys, find 91: %d, find 90: %d\n",
+           (unsigned long)index->size, rb_frozen_find(index, 91),
+           rb_frozen_find(index, 90));
+    rb_frozen_free(index);
+
+    tree = rb_tree_load("31-tree.rbt", &arena);
+    if (!tree)
+        return (1);
+    rb_tree_print(tree);
+    printf("Is valid: %d\n", rb_tree_is_valid(tree));
+    rb_arena_destroy(arena);
+    return (0);
+}
@@ -0,0 +1,146 @@
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rb_trees.h"
+
+/**
+ * rb_tree_save - save the keys of an RB tree to an image file
+ *
+ * The keys are written frozen, in Eytzinger order after a header padded
+ * to RB_IMAGE_KEYS bytes, so rb_frozen_map can search the file in place.
+ * Images use the byte order of the machine that saved them.
+ *
+ * @tree: root of the tree, left unchanged
+ * @path: file to write
+ *
+ * Return: 0 on success, -1 on failure
+ */
+int rb_tree_save(const rb_tree_t *tree, const char *path)
+{
+	unsigned char header[RB_IMAGE_KEYS] = { 0 };
+	rb_image_t image;
+	rb_frozen_t *frozen;
+	FILE *file;
+	int ret = 0;
+
+	frozen = rb_tree_freeze(tree);
+	if (frozen == NULL)
+		return (-1);
+	image.magic = RB_IMAGE_MAGIC;
+	image.key_size = sizeof(int);
+	image.size = frozen->size;
+	memcpy(header, &image, sizeof(image));
+	file = fopen(path, "wb");
+	if (file == NULL)
+		ret = -1;
+	else if (fwrite(header, sizeof(header), 1, file) != 1 ||
+		fwrite(frozen->keys, sizeof(int), frozen->size + 1, file) !=
+		frozen->size + 1)
+		ret = -1;
+	if (file != NULL && fclose(file) != 0)
+		ret = -1;
+	rb_frozen_free(frozen);
+	return (ret);
+}
+
+/**
+ * rb_frozen_map - map an image file as a read-only frozen array
+ *
+ * Nothing is copied: pages are read from the file on first access and
+ * shared with every process mapping the same image.
+ *
+ * @path: image file written by rb_tree_save
+ *
+ * Return: frozen array, NULL if the file can't be mapped or is not a
+ * valid image for this machine
+ */
+rb_frozen_t *rb_frozen_map(const char *path)
+{
+	rb_frozen_t *frozen;
+	rb_image_t image;
+	struct stat st;
+	void *map;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd == -1)
+		return (NULL);
+	if (fstat(fd, &st) == -1 || (size_t)st.st_size < RB_IMAGE_KEYS)
+	{
+		close(fd);
+		return (NULL);
+	}
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return (NULL);
+	memcpy(&image, map, sizeof(image));
+	frozen = malloc(sizeof(*frozen));
+	if (frozen == NULL || image.magic != RB_IMAGE_MAGIC ||
+		image.key_size != sizeof(int) ||
+		image.size >= ((size_t)st.st_size - RB_IMAGE_KEYS) / sizeof(int))
+	{
+		free(frozen);
+		munmap(map, st.st_size);
+		return (NULL);
+	}
+	frozen->keys = (int *)((char *)map + RB_IMAGE_KEYS);
+	frozen->size = image.size;
+	frozen->map = map;
+	frozen->map_size = st.st_size;
+	return (frozen);
+}
+
+/**
+ * rb_tree_load - rebuild a mutable RB tree from an image file
+ *
+ * The image is mapped and the tree built from it in linear time. All the
+ * nodes are carved from a single arena slab instead of one malloc each.
+ *
+ * @path: image file written by rb_tree_save
+ * @arena: receives the arena holding the nodes, free the tree with
+ * rb_arena_destroy. Set to NULL whenever the tree is NULL, nothing is
+ * left to free then
+ *
+ * Return: root of the tree, NULL if it is empty or on failure
+ */
+rb_tree_t *rb_tree_load(const char *path, rb_arena_t **arena)
+{
+	rb_frozen_t *frozen;
+	rb_tree_t *root;
+
+	if (arena == NULL)
+		return (NULL);
+	*arena = NULL;
+	frozen = rb_frozen_map(path);
+	if (frozen == NULL)
+		return (NULL);
+	*arena = rb_arena_create(frozen->size);
+	root = *arena != NULL ? rb_tree_thaw_arena(*arena, frozen) : NULL;
+	rb_frozen_free(frozen);
+	if (root == NULL)
+	{
+		rb_arena_destroy(*arena);
+		*arena = NULL;
+	}
+	return (root);
+}
+
+/**
+ * rb_frozen_free - free a frozen array, or unmap it if it was mapped from
+ * an image file
+ *
+ * @frozen: frozen array to free
+ */
+void rb_frozen_free(rb_frozen_t *frozen)
+{
+	if (frozen == NULL)
+		return;
+	if (frozen->map != NULL)
+		munmap(frozen->map, frozen->map_size);
+	else
+		free(frozen->keys);
+	free(frozen);
+}
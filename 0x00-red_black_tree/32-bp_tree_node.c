@@ -0,0 +1,94 @@
+#include <stddef.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "bp_trees.h"
+
+/**
+ * bp_tree_node - create an empty B+tree node
+ *
+ * @leaf: 1 for a leaf, 0 for an inner node
+ *
+ * Return: pointer to the node, NULL on failure
+ */
+bp_tree_t *bp_tree_node(int leaf)
+{
+	bp_tree_t *node;
+	size_t size, i;
+
+	size = leaf ? offsetof(bp_tree_t, children) : sizeof(bp_tree_t);
+	size = (size + RB_CACHE_LINE - 1) / RB_CACHE_LINE * RB_CACHE_LINE;
+	node = aligned_alloc(RB_CACHE_LINE, size);
+	if (node == NULL)
+		return (NULL);
+	for (i = 0; i < BP_KEYS; i++)
+		node->keys[i] = INT_MAX;
+	node->count = 0;
+	node->leaf = leaf;
+	node->next = NULL;
+	return (node);
+}
+
+/**
+ * bp_tree_upper - count the keys of a node that are not larger than a
+ * value, which is the child to descend into, or where to insert in a leaf
+ *
+ * All BP_KEYS keys are compared at once with SIMD when available, with no
+ * branch on the data; the INT_MAX padding never counts, except when
+ * looking up INT_MAX itself, hence the final clamp.
+ *
+ * @node: node to search
+ * @n: value to rank
+ *
+ * Return: number of keys <= @n
+ */
+size_t bp_tree_upper(const bp_tree_t *node, int n)
+{
+	size_t le;
+#if defined(__AVX2__)
+	__m256i v = _mm256_set1_epi32(n), k;
+	unsigned int gt = 0, i;
+
+	for (i = 0; i < BP_KEYS / 8; i++)
+	{
+		k = _mm256_load_si256((const __m256i *)node->keys + i);
+		gt += __builtin_popcount(_mm256_movemask_ps(
+			_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, v))));
+	}
+	le = BP_KEYS - gt;
+#elif defined(__SSE2__)
+	__m128i v = _mm_set1_epi32(n), k;
+	unsigned int gt = 0, i;
+
+	for (i = 0; i < BP_KEYS / 4; i++)
+	{
+		k = _mm_load_si128((const __m128i *)node->keys + i);
+		gt += __builtin_popcount(_mm_movemask_ps(
+			_mm_castsi128_ps(_mm_cmpgt_epi32(k, v))));
+	}
+	le = BP_KEYS - gt;
+#else
+	size_t i;
+
+	for (i = 0, le = 0; i < BP_KEYS; i++)
+		le += node->keys[i] <= n;
+#endif
+	return (le < node->count ? le : node->count);
+}
+
+/**
+ * bp_tree_delete - free every node of a B+tree
+ *
+ * @tree: root of the tree to free
+ */
+void bp_tree_delete(bp_tree_t *tree)
+{
+	size_t i;
+
+	if (tree == NULL)
+		return;
+	if (!tree->leaf)
+		for (i = 0; i <= tree->count; i++)
+			bp_tree_delete(tree->children[i]);
+	free(tree);
+}
@@ -0,0 +1,50 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "bp_trees.h"
+
+/**
+ * print_key - print a key of a range
+ *
+ * @n: key to print
+ * @data: unused
+ */
+static void print_key(int n, void *data)
+{
+    (void)data;
+    printf(" %d", n);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    bp_tree_t *tree;
+    int array[] = {
+        79, 47, 68, 87, 84, 91, 21, 32, 34, 2,
+        20, 22, 98, 1, 62, 95
+    };
+    size_t n = sizeof(array) / sizeof(array[0]);
+    int i;
+
+    tree = array_to_bp_tree(array, n);
+    if (!tree)
+        return (1);
+    for (i = 100; i < 1000; i += 3)
+        if (!bp_tree_insert(&tree, i))
+            return (1);
+    printf("Root holds %u keys, first separator %d\n", tree->count,
+        tree->keys[0]);
+    printf("Find 84: %s\n", bp_tree_find(tree, 84) ? "found" : "missing");
+    printf("Find 85: %s\n", bp_tree_find(tree, 85) ? "found" : "missing");
+    tree = bp_tree_remove(tree, 84);
+    printf("Find 84 after removal: %s\n",
+        bp_tree_find(tree, 84) ? "found" : "missing");
+    printf("Range [60, 110]:");
+    n = bp_tree_foreach_range(tree, 60, 110, print_key, NULL);
+    printf("\n%lu keys\n", (unsigned long)n);
+    bp_tree_delete(tree);
+    return (0);
+}
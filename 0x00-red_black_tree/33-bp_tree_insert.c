@@ -0,0 +1,110 @@
+#include <string.h>
+#include "bp_trees.h"
+
+/**
+ * bp_split_child - split a full child in two and add the separator to its
+ * parent, which must have room for it
+ *
+ * @parent: parent node
+ * @i: index of the full child
+ *
+ * Return: 0 on success, -1 on failure
+ */
+int bp_split_child(bp_tree_t *parent, size_t i)
+{
+	bp_tree_t *child = parent->children[i], *sibling;
+	size_t half = BP_KEYS / 2, j;
+	int sep;
+
+	sibling = bp_tree_node(child->leaf);
+	if (sibling == NULL)
+		return (-1);
+	if (child->leaf)
+	{
+		/* Leaves keep every key, the separator is copied up */
+		memcpy(sibling->keys, child->keys + half, sizeof(int) * half);
+		sibling->count = half;
+		sibling->next = child->next;
+		child->next = sibling;
+		sep = sibling->keys[0];
+	}
+	else
+	{
+		/* The middle key of an inner node moves up */
+		sep = child->keys[half];
+		sibling->count = BP_KEYS - half - 1;
+		memcpy(sibling->keys, child->keys + half + 1,
+			sizeof(int) * sibling->count);
+		memcpy(sibling->children, child->children + half + 1,
+			sizeof(bp_tree_t *) * (sibling->count + 1));
+	}
+	for (j = half; j < BP_KEYS; j++)
+		child->keys[j] = INT_MAX;
+	child->count = half;
+	memmove(parent->keys + i + 1, parent->keys + i,
+		sizeof(int) * (parent->count - i));
+	memmove(parent->children + i + 2, parent->children + i + 1,
+		sizeof(bp_tree_t *) * (parent->count - i));
+	parent->keys[i] = sep;
+	parent->children[i + 1] = sibling;
+	parent->count++;
+	return (0);
+}
+
+/**
+ * bp_tree_insert - insert a value into a B+tree using a top-down approach
+ *
+ * Every full node met on the way down is split before entering it, so
+ * the leaf always has room and no split has to travel back up.
+ *
+ * @tree: pointer to root node of tree
+ * @n: data to insert
+ *
+ * Return: leaf holding the value, NULL if @n is already in the tree or on
+ * failure
+ */
+bp_tree_t *bp_tree_insert(bp_tree_t **tree, int n)
+{
+	bp_tree_t *node, *root;
+	size_t i;
+
+	if (tree == NULL)
+		return (NULL);
+	if (*tree == NULL)
+	{
+		*tree = bp_tree_node(1);
+		if (*tree == NULL)
+			return (NULL);
+	}
+	if ((*tree)->count == BP_KEYS)
+	{
+		root = bp_tree_node(0);
+		if (root == NULL)
+			return (NULL);
+		root->children[0] = *tree;
+		if (bp_split_child(root, 0) == -1)
+		{
+			free(root);
+			return (NULL);
+		}
+		*tree = root;
+	}
+	for (node = *tree; !node->leaf; node = node->children[i])
+	{
+		i = bp_tree_upper(node, n);
+		if (node->children[i]->count == BP_KEYS)
+		{
+			if (bp_split_child(node, i) == -1)
+				return (NULL);
+			i += node->keys[i] <= n;
+		}
+	}
+	i = bp_tree_upper(node, n);
+	if (i > 0 && node->keys[i - 1] == n)
+		return (NULL);
+	memmove(node->keys + i + 1, node->keys + i,
+		sizeof(int) * (node->count - i));
+	node->keys[i] = n;
+	node->count++;
+	return (node);
+}
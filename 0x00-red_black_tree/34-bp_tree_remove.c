@@ -0,0 +1,161 @@
+#include <string.h>
+#include "bp_trees.h"
+
+/**
+ * bp_borrow_left - move one key from the left sibling of a child into it
+ *
+ * @parent: parent node
+ * @i: index of the child, at least 1
+ */
+static void bp_borrow_left(bp_tree_t *parent, size_t i)
+{
+	bp_tree_t *child = parent->children[i], *left = parent->children[i - 1];
+
+	memmove(child->keys + 1, child->keys, sizeof(int) * child->count);
+	if (child->leaf)
+	{
+		child->keys[0] = left->keys[left->count - 1];
+		parent->keys[i - 1] = child->keys[0];
+	}
+	else
+	{
+		/* Rotate through the separator */
+		memmove(child->children + 1, child->children,
+			sizeof(bp_tree_t *) * (child->count + 1));
+		child->keys[0] = parent->keys[i - 1];
+		child->children[0] = left->children[left->count];
+		parent->keys[i - 1] = left->keys[left->count - 1];
+	}
+	left->keys[--left->count] = INT_MAX;
+	child->count++;
+}
+
+/**
+ * bp_borrow_right - move one key from the right sibling of a child into it
+ *
+ * @parent: parent node
+ * @i: index of the child, smaller than the parent's count
+ */
+static void bp_borrow_right(bp_tree_t *parent, size_t i)
+{
+	bp_tree_t *child = parent->children[i], *right = parent->children[i + 1];
+
+	if (child->leaf)
+	{
+		child->keys[child->count] = right->keys[0];
+		parent->keys[i] = right->keys[1];
+	}
+	else
+	{
+		/* Rotate through the separator */
+		child->keys[child->count] = parent->keys[i];
+		child->children[child->count + 1] = right->children[0];
+		parent->keys[i] = right->keys[0];
+		memmove(right->children, right->children + 1,
+			sizeof(bp_tree_t *) * right->count);
+	}
+	child->count++;
+	memmove(right->keys, right->keys + 1, sizeof(int) * (right->count - 1));
+	right->keys[--right->count] = INT_MAX;
+}
+
+/**
+ * bp_merge - merge a child with its right sibling and drop their
+ * separator from the parent
+ *
+ * @parent: parent node
+ * @i: index of the left child of the pair
+ */
+static void bp_merge(bp_tree_t *parent, size_t i)
+{
+	bp_tree_t *left = parent->children[i], *right = parent->children[i + 1];
+
+	if (left->leaf)
+		left->next = right->next;
+	else
+	{
+		/* The separator comes down between the two halves */
+		left->keys[left->count++] = parent->keys[i];
+		memcpy(left->children + left->count, right->children,
+			sizeof(bp_tree_t *) * (right->count + 1));
+	}
+	memcpy(left->keys + left->count, right->keys,
+		sizeof(int) * right->count);
+	left->count += right->count;
+	free(right);
+	memmove(parent->keys + i, parent->keys + i + 1,
+		sizeof(int) * (parent->count - i - 1));
+	memmove(parent->children + i + 1, parent->children + i + 2,
+		sizeof(bp_tree_t *) * (parent->count - i - 1));
+	parent->keys[--parent->count] = INT_MAX;
+}
+
+/**
+ * bp_fix_child - give a child at the minimum size one more key, by
+ * borrowing from a sibling or merging with it
+ *
+ * @parent: parent node, above the minimum size unless it is the root
+ * @i: index of the child
+ *
+ * Return: index of the child that now covers the child's key range
+ */
+size_t bp_fix_child(bp_tree_t *parent, size_t i)
+{
+	if (i > 0 && parent->children[i - 1]->count > BP_MIN)
+		bp_borrow_left(parent, i);
+	else if (i < parent->count && parent->children[i + 1]->count > BP_MIN)
+		bp_borrow_right(parent, i);
+	else if (i < parent->count)
+		bp_merge(parent, i);
+	else
+		bp_merge(parent, --i);
+	return (i);
+}
+
+/**
+ * bp_tree_remove - remove a value from a B+tree using a top-down approach
+ *
+ * Every node at the minimum size met on the way down gets a key from a
+ * sibling first, so the leaf can always lose one and nothing has to be
+ * fixed on the way back up. Separators are left as they are: they still
+ * split the key ranges correctly.
+ *
+ * @root: root of tree
+ * @n: data to remove
+ *
+ * Return: root of tree
+ */
+bp_tree_t *bp_tree_remove(bp_tree_t *root, int n)
+{
+	bp_tree_t *node, *child;
+	size_t i;
+
+	if (root == NULL)
+		return (NULL);
+	for (node = root; !node->leaf; node = node->children[i])
+	{
+		i = bp_tree_upper(node, n);
+		if (node->children[i]->count <= BP_MIN)
+			i = bp_fix_child(node, i);
+	}
+	i = bp_tree_upper(node, n);
+	if (i > 0 && node->keys[i - 1] == n)
+	{
+		memmove(node->keys + i - 1, node->keys + i,
+			sizeof(int) * (node->count - i));
+		node->keys[--node->count] = INT_MAX;
+	}
+	/* Merges may have emptied the root */
+	while (!root->leaf && root->count == 0)
+	{
+		child = root->children[0];
+		free(root);
+		root = child;
+	}
+	if (root->count == 0)
+	{
+		free(root);
+		root = NULL;
+	}
+	return (root);
+}
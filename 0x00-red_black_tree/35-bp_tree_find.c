@@ -0,0 +1,61 @@
+#include "bp_trees.h"
+
+/**
+ * bp_tree_find - find the leaf holding a value in a B+tree
+ *
+ * @tree: root of the tree
+ * @n: value to find
+ *
+ * Return: leaf holding @n, NULL if not found
+ */
+bp_tree_t *bp_tree_find(bp_tree_t *tree, int n)
+{
+	size_t i;
+
+	if (tree == NULL)
+		return (NULL);
+	while (!tree->leaf)
+	{
+		tree = tree->children[bp_tree_upper(tree, n)];
+		RB_PREFETCH(tree->keys + 16);
+	}
+	i = bp_tree_upper(tree, n);
+	return (i > 0 && tree->keys[i - 1] == n ? tree : NULL);
+}
+
+/**
+ * bp_tree_foreach_range - call a function on every key of a B+tree in a
+ * closed range, in ascending order, walking the chain of leaves
+ *
+ * @tree: root of the tree
+ * @lo: lower bound of the range
+ * @hi: upper bound of the range
+ * @action: function called on each key in the range
+ * @data: argument passed through to @action
+ *
+ * Return: number of keys visited
+ */
+size_t bp_tree_foreach_range(bp_tree_t *tree, int lo, int hi,
+	void (*action)(int n, void *data), void *data)
+{
+	size_t i, count = 0;
+
+	if (tree == NULL || action == NULL || lo > hi)
+		return (0);
+	while (!tree->leaf)
+		tree = tree->children[bp_tree_upper(tree, lo)];
+	i = bp_tree_upper(tree, lo);
+	if (i > 0 && tree->keys[i - 1] == lo)
+		i--;
+	for (; tree != NULL; tree = tree->next, i = 0)
+	{
+		for (; i < tree->count; i++)
+		{
+			if (tree->keys[i] > hi)
+				return (count);
+			action(tree->keys[i], data);
+			count++;
+		}
+	}
+	return (count);
+}
@@ -0,0 +1,133 @@
+#include <string.h>
+#include "bp_trees.h"
+
+/**
+ * compare_int - qsort comparator for integers
+ *
+ * @a: pointer to first integer
+ * @b: pointer to second integer
+ *
+ * Return: negative, zero or positive as @a is less, equal or greater than @b
+ */
+static int compare_int(const void *a, const void *b)
+{
+	int x = *(const int *)a, y = *(const int *)b;
+
+	return ((x > y) - (x < y));
+}
+
+/**
+ * bp_build_level - build one level of a B+tree above the nodes of the
+ * level below, spreading the children evenly over the new nodes
+ *
+ * @nodes: nodes of the level below, replaced by the new level
+ * @mins: smallest key below each node, replaced for the new level
+ * @count: number of nodes of the level below, more than 1
+ *
+ * Return: number of nodes in the new level, 0 on failure
+ */
+static size_t bp_build_level(bp_tree_t **nodes, int *mins, size_t count)
+{
+	size_t parents, p, j, k = 0, c;
+	bp_tree_t *node;
+
+	parents = (count + BP_KEYS) / (BP_KEYS + 1);
+	for (p = 0; p < parents; p++, k += c)
+	{
+		c = count / parents + (p < count % parents);
+		node = bp_tree_node(0);
+		if (node == NULL)
+		{
+			for (j = 0; j < p; j++)
+				bp_tree_delete(nodes[j]);
+			for (j = k; j < count; j++)
+				bp_tree_delete(nodes[j]);
+			return (0);
+		}
+		memcpy(node->children, nodes + k, sizeof(*nodes) * c);
+		memcpy(node->keys, mins + k + 1, sizeof(int) * (c - 1));
+		node->count = c - 1;
+		nodes[p] = node;
+		mins[p] = mins[k];
+	}
+	return (parents);
+}
+
+/**
+ * bp_build - build a B+tree from strictly ascending keys, in linear time,
+ * with full leaves spread evenly
+ *
+ * @keys: keys to insert
+ * @size: number of keys, more than 0
+ *
+ * Return: root of the tree, NULL on failure
+ */
+static bp_tree_t *bp_build(const int *keys, size_t size)
+{
+	size_t leaves, count, j, k = 0, c;
+	bp_tree_t **nodes, *root = NULL;
+	int *mins;
+
+	leaves = (size + BP_KEYS - 1) / BP_KEYS;
+	nodes = malloc(sizeof(*nodes) * leaves);
+	mins = malloc(sizeof(*mins) * leaves);
+	for (j = 0; nodes != NULL && mins != NULL && j < leaves; j++, k += c)
+	{
+		c = size / leaves + (j < size % leaves);
+		nodes[j] = bp_tree_node(1);
+		if (nodes[j] == NULL)
+			break;
+		memcpy(nodes[j]->keys, keys + k, sizeof(int) * c);
+		nodes[j]->count = c;
+		mins[j] = keys[k];
+		if (j > 0)
+			nodes[j - 1]->next = nodes[j];
+	}
+	if (j < leaves)
+	{
+		while (nodes != NULL && j > 0)
+			free(nodes[--j]);
+	}
+	else
+	{
+		for (count = leaves; count > 1;)
+			count = bp_build_level(nodes, mins, count);
+		root = count == 1 ? nodes[0] : NULL;
+	}
+	free(nodes);
+	free(mins);
+	return (root);
+}
+
+/**
+ * array_to_bp_tree - convert an array to a B+tree
+ *
+ * The keys are copied, sorted and stripped of duplicates, then the tree
+ * is built bottom-up in linear time, which gives the same set of keys as
+ * inserting each element one at a time.
+ *
+ * @array: array to convert
+ * @size: size of array
+ *
+ * Return: root node of the B+tree
+ */
+bp_tree_t *array_to_bp_tree(int *array, size_t size)
+{
+	size_t i, unique;
+	bp_tree_t *root;
+	int *keys;
+
+	if (array == NULL || size == 0)
+		return (NULL);
+	keys = malloc(sizeof(*keys) * size);
+	if (keys == NULL)
+		return (NULL);
+	memcpy(keys, array, sizeof(*keys) * size);
+	qsort(keys, size, sizeof(*keys), compare_int);
+	for (i = 1, unique = 1; i < size; i++)
+		if (keys[i] != keys[unique - 1])
+			keys[unique++] = keys[i];
+	root = bp_build(keys, unique);
+	free(keys);
+	return (root);
+}
@@ -0,0 +1,222 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "rb_bench.h"
+#include "bp_trees.h"
+
+#define BENCH_OPS	5
+#define BENCH_BACKENDS	2
+#define BENCH_BUDGET	1000000
+
+/**
+ * struct result_s - Measurements of one operation, summed over repetitions
+ *
+ * @seconds: Time spent
+ * @misses: Cache misses, -1 if unavailable
+ * @rss: Largest peak resident set size, in kB
+ * @rotations: Rotations, only counted when built with RB_STATS
+ */
+typedef struct result_s
+{
+    double seconds;
+    long long misses;
+    long rss;
+    size_t rotations;
+} result_t;
+
+static const char * const workloads[] = {
+    "sequential", "random", "zipf", "adversarial"
+};
+static const char * const ops[] = {
+    "insert", "find", "validate", "remove", "build"
+};
+static const char * const backends[] = {"rb", "bp"};
+static volatile size_t sink;
+
+/**
+ * run_op - run one operation over all the keys of a workload
+ *
+ * @op: index of the operation in ops
+ * @keys: keys of the workload
+ * @n: number of keys
+ * @tree: tree built by insert, checked by find and validate, emptied by
+ * remove
+ */
+static void run_op(int op, int *keys, size_t n, rb_tree_t **tree)
+{
+    size_t i, hits = 0;
+
+    if (op == 0)
+        for (i = 0; i < n; i++)
+            rb_tree_insert(tree, keys[i]);
+    else if (op == 1)
+        for (i = 0; i < n; i++)
+            hits += rb_tree_find(*tree, keys[i]) != NULL;
+    else if (op == 2)
+        hits = rb_tree_is_valid(*tree);
+    else if (op == 3)
+        for (i = 0; i < n; i++)
+            *tree = rb_tree_remove(*tree, keys[i]);
+    else
+        *tree = array_to_rb_tree(keys, n);
+    sink = hits;
+}
+
+/**
+ * run_bp_op - run one operation over all the keys of a workload on a
+ * B+tree. There is no B+tree validator, so validate does nothing
+ *
+ * @op: index of the operation in ops
+ * @keys: keys of the workload
+ * @n: number of keys
+ * @tree: tree built by insert, checked by find, emptied by remove
+ */
+static void run_bp_op(int op, int *keys, size_t n, bp_tree_t **tree)
+{
+    size_t i, hits = 0;
+
+    if (op == 0)
+        for (i = 0; i < n; i++)
+            bp_tree_insert(tree, keys[i]);
+    else if (op == 1)
+        for (i = 0; i < n; i++)
+            hits += bp_tree_find(*tree, keys[i]) != NULL;
+    else if (op == 3)
+        for (i = 0; i < n; i++)
+            *tree = bp_tree_remove(*tree, keys[i]);
+    else if (op == 4)
+        *tree = array_to_bp_tree(keys, n);
+    sink = hits;
+}
+
+/**
+ * run_case - run every operation of a backend on a workload, several
+ * times over for small sizes, and print one JSON object per operation
+ *
+ * @backend: index of the backend in backends
+ * @workload: workload to run
+ * @n: number of keys
+ * @fd: cache miss counter, -1 if unavailable
+ *
+ * Return: 0 on success, 1 on failure
+ */
+static int run_case(int backend, rb_workload_t workload, size_t n, int fd)
+{
+    result_t results[BENCH_OPS];
+    size_t reps, r, per_op;
+    rb_tree_t *tree = NULL;
+    bp_tree_t *bp = NULL;
+    char misses[32], rotations[32];
+    int *keys, op;
+    double start;
+    long long count;
+    long rss;
+
+    keys = rb_bench_keys(workload, n, 98 + n);
+    if (keys == NULL)
+        return (1);
+    memset(results, 0, sizeof(results));
+    reps = n < BENCH_BUDGET ? BENCH_BUDGET / n : 1;
+    for (r = 0; r < reps; r++)
+    {
+        for (op = 0; op < BENCH_OPS; op++)
+        {
+            rb_bench_peak_rss(1);
+#ifdef RB_STATS
+            rb_stats_reset();
+#endif
+            rb_bench_perf_start(fd);
+            start = rb_bench_now();
+            if (backend == 0)
+                run_op(op, keys, n, &tree);
+            else
+                run_bp_op(op, keys, n, &bp);
+            results[op].seconds += rb_bench_now() - start;
+            count = rb_bench_perf_stop(fd);
+#ifdef RB_STATS
+            results[op].rotations += rb_stats.rotations;
+#endif
+            results[op].misses = count == -1 ? -1 :
+                results[op].misses + count;
+            rss = rb_bench_peak_rss(0);
+            if (rss > results[op].rss)
+                results[op].rss = rss;
+        }
+        rb_tree_delete(tree);
+        bp_tree_delete(bp);
+        tree = NULL;
+        bp = NULL;
+    }
+    free(keys);
+    for (op = 0; op < BENCH_OPS; op++)
+    {
+        if (backend == 1 && op == 2)
+            continue;
+        per_op = op == 2 ? reps : reps * n;
+        if (results[op].misses == -1)
+            strcpy(misses, "null");
+        else
+            sprintf(misses, "%.3f", (double)results[op].misses / per_op);
+#ifdef RB_STATS
+        if (backend == 0)
+            sprintf(rotations, "%.3f",
+                (double)results[op].rotations / per_op);
+        else
+            strcpy(rotations, "null");
+#else
+        strcpy(rotations, "null");
+#endif
+        printf("{\"backend\":\"%s\",\"workload\":\"%s\",\"op\":\"%s\","
+            "\"n\":%lu,\"reps\":%lu,\"node_bytes\":%lu,\"ns_per_op\":%.1f,"
+            "\"rotations_per_op\":%s,\"cache_misses_per_op\":%s,"
+            "\"peak_rss_kb\":%ld}\n", backends[backend], workloads[workload],
+            ops[op], (unsigned long)n, (unsigned long)reps,
+            (unsigned long)(backend == 0 ? sizeof(rb_tree_t) :
+            sizeof(bp_tree_t)),
+            results[op].seconds * 1e9 / per_op, rotations, misses,
+            results[op].rss);
+    }
+    fflush(stdout);
+    return (0);
+}
+
+/**
+ * main - Entry point, benchmarks the tree operations of each backend on
+ * every workload at sizes from 1e3 up to a maximum, by powers of 10
+ *
+ * Usage: ./rb_bench [max_size [workload|all [rb|bp]]]
+ *
+ * @argc: number of arguments
+ * @argv: arguments
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(int argc, char **argv)
+{
+    size_t n, max = 1000000;
+    int workload, backend, fd, status = 0;
+
+    if (argc > 1)
+        max = strtoul(argv[1], NULL, 10);
+    fd = rb_bench_perf_open();
+    for (n = 1000; n <= max && status == 0; n *= 10)
+    {
+        for (workload = 0; workload < RB_WORKLOADS && status == 0; workload++)
+        {
+            if (argc > 2 && strcmp(argv[2], "all") != 0 &&
+                strcmp(argv[2], workloads[workload]) != 0)
+                continue;
+            for (backend = 0; backend < BENCH_BACKENDS && status == 0;
+                backend++)
+            {
+                if (argc > 3 && strcmp(argv[3], backends[backend]) != 0)
+                    continue;
+                status = run_case(backend, workload, n, fd);
+            }
+        }
+    }
+    if (fd != -1)
+        close(fd);
+    return (status);
+}
@@ -0,0 +1,93 @@
+#include <math.h>
+#include "rb_bench.h"
+
+/**
+ * rb_bench_mix - splitmix64 step, a fast generator with good mixing
+ *
+ * @state: generator state, advanced
+ *
+ * Return: next pseudo-random 64-bit number
+ */
+static uint64_t rb_bench_mix(uint64_t *state)
+{
+	uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return (z ^ (z >> 31));
+}
+
+/**
+ * rb_bench_zipf - fill an array with Zipfian draws, using the method of
+ * Gray et al. "Quickly generating billion-record synthetic databases"
+ *
+ * @keys: array to fill
+ * @n: number of draws, also the number of distinct ranks
+ * @seed: generator seed
+ */
+static void rb_bench_zipf(int *keys, size_t n, uint64_t seed)
+{
+	double theta = RB_BENCH_ZIPF_THETA, zetan = 0, zeta2, alpha, eta, u;
+	uint64_t rank, hashed;
+	size_t i;
+
+	for (i = 1; i <= n; i++)
+		zetan += 1 / pow((double)i, theta);
+	zeta2 = 1 + 1 / pow(2, theta);
+	alpha = 1 / (1 - theta);
+	eta = (1 - pow(2.0 / n, 1 - theta)) / (1 - zeta2 / zetan);
+	for (i = 0; i < n; i++)
+	{
+		u = (rb_bench_mix(&seed) >> 11) * (1.0 / 9007199254740992.0);
+		if (u * zetan < 1)
+			rank = 0;
+		else if (u * zetan < zeta2)
+			rank = 1;
+		else
+			rank = (uint64_t)(n * pow(eta * u - eta + 1, alpha));
+		hashed = rank;
+		keys[i] = (int)(rb_bench_mix(&hashed) & INT_MAX);
+	}
+}
+
+/**
+ * rb_bench_keys - generate the keys of a benchmark workload
+ *
+ * @workload: kind of key sequence
+ * @n: number of keys
+ * @seed: generator seed, the same seed gives the same keys
+ *
+ * Return: array of @n keys to free, NULL on failure
+ */
+int *rb_bench_keys(rb_workload_t workload, size_t n, uint64_t seed)
+{
+	size_t i, j;
+	int *keys, tmp;
+
+	if (n == 0 || n > INT_MAX)
+		return (NULL);
+	keys = malloc(sizeof(*keys) * n);
+	if (keys == NULL)
+		return (NULL);
+	if (workload == RB_ZIPF)
+	{
+		rb_bench_zipf(keys, n, seed);
+		return (keys);
+	}
+	for (i = 0; i < n; i++)
+		keys[i] = (int)i;
+	if (workload == RB_RANDOM)
+	{
+		for (i = n - 1; i > 0; i--)
+		{
+			j = rb_bench_mix(&seed) % (i + 1);
+			tmp = keys[i], keys[i] = keys[j], keys[j] = tmp;
+		}
+	}
+	else if (workload == RB_ADVERSARIAL)
+	{
+		for (i = 0; i < n; i++)
+			keys[i] = (int)(i % 2 ? n - 1 - i / 2 : i / 2);
+	}
+	return (keys);
+}
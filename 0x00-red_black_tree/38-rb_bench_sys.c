@@ -0,0 +1,135 @@
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#include "rb_bench.h"
+
+/**
+ * rb_bench_now - read a monotonic clock
+ *
+ * Return: time in seconds
+ */
+double rb_bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+/**
+ * rb_bench_perf_open - open a hardware counter of the cache misses of the
+ * calling thread, in user space only
+ *
+ * Return: counter to pass to rb_bench_perf_start and rb_bench_perf_stop
+ * and close, -1 if the platform or its settings don't allow it
+ */
+int rb_bench_perf_open(void)
+{
+#ifdef __linux__
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return ((int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+	return (-1);
+#endif
+}
+
+/**
+ * rb_bench_perf_start - reset a counter and start counting
+ *
+ * @fd: counter from rb_bench_perf_open, ignored if -1
+ */
+void rb_bench_perf_start(int fd)
+{
+#ifdef __linux__
+	if (fd == -1)
+		return;
+	ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+	ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#else
+	(void)fd;
+#endif
+}
+
+/**
+ * rb_bench_perf_stop - stop counting and read a counter
+ *
+ * @fd: counter from rb_bench_perf_open
+ *
+ * Return: events counted since rb_bench_perf_start, -1 if unavailable
+ */
+long long rb_bench_perf_stop(int fd)
+{
+#ifdef __linux__
+	long long count;
+
+	if (fd == -1)
+		return (-1);
+	ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+	if (read(fd, &count, sizeof(count)) != sizeof(count))
+		return (-1);
+	return (count);
+#else
+	(void)fd;
+	return (-1);
+#endif
+}
+
+/**
+ * rb_bench_peak_rss - read the peak resident set size of the process
+ *
+ * On Linux the peak can be reset, so each benchmark reports its own peak
+ * rather than the largest one so far. Elsewhere, and on kernels that
+ * can't reset it, the peak only grows.
+ *
+ * @reset: if not 0, reset the peak to the current size first
+ *
+ * Return: peak resident set size in kB, -1 if unavailable
+ */
+long rb_bench_peak_rss(int reset)
+{
+	struct rusage usage;
+	long peak = -1;
+	char buf[4096], *line;
+	ssize_t len;
+	int fd;
+
+	if (reset)
+	{
+		/* A failed reset leaves the peak growing, nothing else to do */
+		fd = open("/proc/self/clear_refs", O_WRONLY);
+		if (fd != -1)
+		{
+			len = write(fd, "5", 1);
+			close(fd);
+		}
+	}
+	fd = open("/proc/self/status", O_RDONLY);
+	len = fd != -1 ? read(fd, buf, sizeof(buf) - 1) : -1;
+	if (fd != -1)
+		close(fd);
+	if (len > 0)
+	{
+		buf[len] = '\0';
+		line = strstr(buf, "VmHWM:");
+		if (line != NULL)
+			peak = strtol(line + 6, NULL, 10);
+	}
+	if (peak == -1 && getrusage(RUSAGE_SELF, &usage) == 0)
+		peak = usage.ru_maxrss;
+	return (peak);
+}
@@ -0,0 +1,26 @@
+#include <string.h>
+#include "rb_trees.h"
+
+#ifdef RB_STATS
+_Thread_local rb_stats_t rb_stats;
+
+/**
+ * rb_stats_get - read the rebalancing counters of the calling thread
+ *
+ * Return: copy of the counters since the thread started or since the
+ * last rb_stats_reset
+ */
+rb_stats_t rb_stats_get(void)
+{
+	return (rb_stats);
+}
+
+/**
+ * rb_stats_reset - set the rebalancing counters of the calling thread
+ * back to zero
+ */
+void rb_stats_reset(void)
+{
+	memset(&rb_stats, 0, sizeof(rb_stats));
+}
+#endif /* RB_STATS */
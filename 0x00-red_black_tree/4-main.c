@@ -0,0 +1,36 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+void rb_tree_print(const rb_tree_t *tree);
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree;
+    int array[] = {
+        79, 47, 68, 87, 84, 91, 21, 32, 34, 2,
+        20, 22, 98, 1, 62, 95
+    };
+    size_t n = sizeof(array) / sizeof(array[0]);
+
+    tree = array_to_rb_tree(array, n);
+    if (!tree)
+        return (1);
+    rb_tree_print(tree);
+    tree = rb_tree_remove(tree, 79);
+    printf("Removed: %d\n", 79);
+    rb_tree_print(tree);
+    tree = rb_tree_remove(tree, 32);
+    printf("Removed: %d\n", 32);
+    rb_tree_print(tree);
+    tree = rb_tree_remove(tree, 2);
+    printf("Removed: %d\n", 2);
+    rb_tree_print(tree);
+    printf("Is valid: %d\n", rb_tree_is_valid(tree));
+    rb_tree_delete(tree);
+    return (0);
+}
@@ -11,235 +11,161 @@
  */
 rb_tree_t *rb_tree_remove(rb_tree_t *root, int n)
 {
-	int done;
-
-	done = 0;
-	root = rb_tree_remove_r(root, n, &done);
-	if (root != NULL)
-		root->color = BLACK;
-
-	return (root);
+	return (rb_tree_remove_arena(NULL, root, n));
 }
 
 /**
- * rb_tree_remove_r - recursive helper function to actually delete the node
+ * rb_tree_remove_arena - remove an RB tree node whose memory belongs to an
+ * arena
  *
- * @root: root of the current subtree
- * @n: data of node to delete
- * @done: pointer to integer specifying if we're done balancing
+ * @arena: arena the nodes came from, or NULL if they came from malloc
+ * @root: root of tree
+ * @n: data to remove
  *
  * Return: root of tree
  */
-rb_tree_t *rb_tree_remove_r(rb_tree_t *root, int n, int *done)
+rb_tree_t *rb_tree_remove_arena(rb_arena_t *arena, rb_tree_t *root, int n)
 {
-	int direction;
-	rb_tree_t *save;
-
-	if (root == NULL)
-		*done = 1;
-	else
-	{
-		if (n == root->n)
-		{
-			if (root->left == NULL || root->right == NULL)
-			{
-				if (root->left == NULL)
-					save = root->right;
-				if (IS_RED(root))
-					*done = 1;
-				else if (IS_RED(save))
-				{
-					save->color = BLACK;
-					*done = 1;
-				}
-				free(root);
-				return (save);
-			}
-			else
-			{
-				save = root->left;
-				while (save->right != NULL)
-					save = save->right;
-				root->n = save->n;
-				n = save->n;
-			}
-		}
-		direction = remove_recurse_direction_helper(root, n, done);
-		if (!*done)
-			root = rb_rebalance(root, direction, done);
-	}
-	return (root);
+	return (rb_tree_remove_key(arena, root, RB_KEY_OF(n)));
 }
 
 /**
- * remove_recurse_direction_helper - encapsulates the code choosing
- * which direction in the RB tree to recurse into
+ * rb_tree_remove_key - remove the node holding a key using a topdown
+ * approach
  *
- * @root: root of subtree
- * @n: number to remove
- * @done: pointer to integer specifying if we're done balancing
+ * A red node is pushed down the search path so the node finally unlinked
+ * is always red, which means nothing has to be fixed on the way back up.
+ * With RB_MULTISET a key occurring more than once only loses an
+ * occurrence, the pass stopping there: every push down on the way keeps
+ * the tree valid.
  *
- * Return: direction to recurse
+ * @arena: arena the nodes came from, or NULL if they came from malloc
+ * @root: root of tree
+ * @key: key to remove, as given by RB_KEY_OF or RB_PAIR_KEY
+ *
+ * Return: root of tree
  */
-int remove_recurse_direction_helper(rb_tree_t *root, int n, int *done)
+rb_tree_t *rb_tree_remove_key(rb_arena_t *arena, rb_tree_t *root,
+	long long key)
 {
-	int direction;
+	rb_tree_t head = { 0 }; /* False tree root */
+	rb_tree_t *q, *p, *g;   /* Iterator, parent & grandparent */
+	rb_tree_t *f, *child;   /* Found node & child of the unlinked node */
+	int dir = 1, last;
 
-	if (n > root->n)
+	if (root == NULL)
+		return (NULL);
+	q = &head;
+	g = p = f = NULL;
+	q->right = root;
+	/* Search down for the in-order predecessor of the target */
+	RB_STAT_DESCENT();
+	while (RB_LINK(q, dir) != NULL)
 	{
-		direction = 1;
-		root->right = rb_tree_remove_r(root->right, n, done);
-		if (root->right != NULL)
-			root->right->parent = root;
+		RB_STAT_STEP();
+		last = dir;
+		g = p, p = q;
+		q = RB_LINK(q, dir);
+		dir = RB_KEY(q) < key;
+		if (RB_KEY(q) == key)
+		{
+#ifdef RB_MULTISET
+			if (q->count > 1)
+			{
+				q->count--;
+				RB_AUGMENT_PATH(q);
+				break;
+			}
+#endif
+			f = q;
+		}
+		if (!IS_RED(q) && !IS_RED(RB_LINK(q, dir)))
+			p = rb_rebalance(q, p, g, dir, last);
 	}
-	else
+	if (f != NULL)
 	{
-		direction = 0;
-		root->left = rb_tree_remove_r(root->left, n, done);
-		if (root->left != NULL)
-			root->left->parent = root;
+		/* Replace the target's data and unlink the bottom node */
+		RB_MOVE_KEY(f, q);
+		child = RB_LINK(q, q->left == NULL);
+		RB_LINK(p, p->right == q) = child;
+		if (child != NULL)
+			RB_SET_PARENT(child, (p == &head) ? NULL : p);
+		rb_arena_free(arena, q);
+		if (p != &head)
+			RB_AUGMENT_PATH(p);
 	}
+	root = head.right;
+	if (root != NULL)
+		RB_SET_COLOR(root, BLACK);
 
-	return (direction);
+	return (root);
 }
 
 /**
- * rb_rebalance - rebalance any red or black violations made by deleting
- * a node
+ * rb_rebalance - push a red node down to @q, the next node on the
+ * search path, when it and its child in the search direction are black
  *
- * @root: root of the subtree
- * @direction: which child to choose
- * @done: whether we're finished balancing or not, 1 for finished, 0 for not
+ * @q: current node
+ * @p: parent of @q
+ * @g: grandparent of @q
+ * @dir: direction the search continues in from @q
+ * @last: direction taken from @p to @q
  *
- * Return: root of subtree
+ * Return: the new parent of @q
  */
-rb_tree_t *rb_rebalance(rb_tree_t *root, int direction, int *done)
+rb_tree_t *rb_rebalance(rb_tree_t *q, rb_tree_t *p, rb_tree_t *g, int dir,
+	int last)
 {
-	rb_tree_t *p;
 	rb_tree_t *s;
 
-	p = root;
-	if (direction)
-		s = root->left;
-	else
-		s = root->right;
-	/* Case reduction, remove red sibling */
-	if (IS_RED(s))
-	{
-		root = single_rotate(root, direction);
-		if (direction)
-			s = p->left;
-		else
-			s = p->right;
-	}
-	if (s != NULL)
-	{
-		if (!IS_RED(s->left) && !IS_RED(s->right))
-		{
-			if (IS_RED(p))
-				*done = 1;
-			p->color = BLACK;
-			s->color = RED;
-		}
-		else
-			rebalance_red_siblings(direction, p, s, root, done);
-	}
-	return (root);
-}
-
-/**
- * rebalance_red_siblings - rebalances the red siblings
- *
- * @direction: which child to choose
- * @p: parent node
- * @s: sibling node
- * @root: root of nodes
- * @done: whether we're done balancing or not. 1 for done, 0 for not done
- */
-void rebalance_red_siblings(
-	int direction, rb_tree_t *p, rb_tree_t *s, rb_tree_t *root, int *done)
-{
-	rb_color_t save_color = p->color;
-	int new_root = (root == p);
-
-	if (direction)
+	RB_STAT(push_downs, 1);
+	if (IS_RED(RB_LINK(q, !dir)))
 	{
-		if (IS_RED(s->left))
-			p = single_rotate(p, direction);
-		else
-			p = double_rotate(p, direction);
+		/* Rotate the red child up, @q becomes red below it */
+		RB_LINK(p, last) = single_rotate_color_swap(q, dir, COLOR_SWAP);
+		return (RB_LINK(p, last));
 	}
-	else
+	s = RB_LINK(p, !last);
+	if (s == NULL)
+		return (p);
+	if (!IS_RED(s->left) && !IS_RED(s->right))
 	{
-		if (IS_RED(s->right))
-			p = single_rotate(p, direction);
-		else
-			p = double_rotate(p, direction);
+		/* Color flip */
+		RB_STAT(color_flips, 1);
+		RB_SET_COLOR(p, BLACK);
+		RB_SET_COLOR(s, RED);
+		RB_SET_COLOR(q, RED);
 	}
-	p->color = save_color;
-	p->left->color = BLACK;
-	p->right->color = BLACK;
-	if (new_root)
-		root = p;
 	else
-	{
-		if (direction)
-			root->right = p;
-		else
-			root->left = p;
-	}
-	*done = 1;
-}
-
-/**
- * single_rotate - rotate a binary tree from a given @root
- *
- * @root: root to rotate
- * @direction: direction to rotate. 1 is right, 0 is left
- *
- * Return: the new root after rotation
- */
-rb_tree_t *single_rotate(rb_tree_t *root, int direction)
-{
-    rb_tree_t *tmp;
+		rebalance_red_siblings(q, p, g, s, last);
 
-    if (direction)
-    {
-        tmp = root->left;
-        root->left = tmp->right;
-        tmp->right = root;
-        tmp->parent = root->parent;
-        root->parent = tmp;
-    }
-    else
-    {
-        tmp = root->right;
-        root->right = tmp->left;
-        tmp->left = root;
-        tmp->parent = root->parent;
-        root->parent = tmp;
-    }
-    root->color = RED;
-    tmp->color = BLACK;
-    return (tmp);
+	return (p);
 }
 
 /**
- * double_rotate - rotate a binary tree from a given @root twice. This is
- * used specifically when there is an inner child of a node that needs to
- * be rotated, and needs to be moved to the outside before the proper
- * rotation can be performed.
+ * rebalance_red_siblings - make @q red when its sibling has a red child,
+ * by rotating that red child up in place of @p
  *
- * @root: root to rotate
- * @direction: direction to rotate. 1 is right, 0 is left
- *
- * Return: the new root after rotation
+ * @q: current node
+ * @p: parent of @q
+ * @g: grandparent of @q
+ * @s: sibling of @q
+ * @last: direction taken from @p to @q
  */
-rb_tree_t *double_rotate(rb_tree_t *root, int direction)
+void rebalance_red_siblings(rb_tree_t *q, rb_tree_t *p, rb_tree_t *g,
+	rb_tree_t *s, int last)
 {
-    if (direction)
-        root->left = single_rotate(root->left, !direction);
-    else
-        root->right = single_rotate(root->right, !direction);
-    return (single_rotate(root, direction));
+	rb_tree_t *top;
+	int dir2 = g->right == p;
+
+	if (IS_RED(RB_LINK(s, last)))
+		top = double_rotate(p, last);
+	else
+		top = single_rotate_color_swap(p, last, COLOR_SWAP);
+	RB_LINK(g, dir2) = top;
+	/* Ensure correct coloring */
+	RB_SET_COLOR(q, RED);
+	RB_SET_COLOR(top, RED);
+	RB_SET_COLOR(top->left, BLACK);
+	RB_SET_COLOR(top->right, BLACK);
 }
@@ -0,0 +1,55 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "rb_trees.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree = NULL, *node;
+    rb_validator_t *validator;
+    int i;
+
+    for (i = 0; i < 100000; i++)
+        if (!rb_tree_insert(&tree, (i * 7919) % 100003))
+            return (1);
+    printf("Valid on 4 threads: %d\n", rb_tree_validate(tree, 4));
+
+    validator = rb_validator_create(4);
+    if (!validator)
+        return (1);
+    printf("First check, full: %d\n", rb_validator_check(validator, tree));
+    for (i = 0; i < 1000; i++)
+    {
+        tree = rb_tree_remove(tree, i * 13);
+        rb_validator_touch(validator, i * 13);
+    }
+    printf("After 1000 removals, incremental: %d\n",
+        rb_validator_check(validator, tree));
+
+    node = rb_tree_find(tree, 5000);
+    node->n = 5001;
+    rb_validator_touch(validator, 5000);
+    printf("Corrupted key, incremental: %d\n",
+        rb_validator_check(validator, tree));
+    node->n = 5000;
+    printf("Repaired, full: %d\n", rb_validator_check(validator, tree));
+
+    /* Off the key's own path: down to the predecessor that replaced it */
+    i = tree->n;
+    tree = rb_tree_remove(tree, i);
+    rb_validator_touch(validator, i);
+    node = tree->left->right->right;
+    RB_SET_COLOR(node, RB_COLOR(node) == RED ? BLACK : RED);
+    printf("Corrupted predecessor path, incremental: %d\n",
+        rb_validator_check(validator, tree));
+    RB_SET_COLOR(node, RB_COLOR(node) == RED ? BLACK : RED);
+    printf("Repaired, full: %d\n", rb_validator_check(validator, tree));
+
+    rb_validator_destroy(validator);
+    rb_tree_delete(tree);
+    return (0);
+}
@@ -0,0 +1,207 @@
+#include "rb_trees.h"
+
+/**
+ * rb_check_subtree - check a whole subtree, iteratively so that even a
+ * degenerate tree can't overflow the call stack
+ *
+ * The walk goes down left children and stacks the right ones. Bounds are
+ * narrowed on the way down, so a node reachable twice, and in particular a
+ * cycle, breaks the ordering and stops the walk.
+ *
+ * @start: subtree to check
+ * @height: black nodes on every path to a leaf, set by the first leaf
+ * found if 0, checked against the others
+ *
+ * Return: 1 if the subtree is valid, 0 if not, -1 if memory ran out
+ */
+static int rb_check_subtree(const rb_check_t *start, size_t *height)
+{
+	rb_check_t *stack, *tmp, top;
+	const rb_tree_t *node;
+	size_t size = 64, count = 1;
+	int valid = 1;
+
+	stack = malloc(sizeof(*stack) * size);
+	if (stack == NULL)
+		return (-1);
+	stack[0] = *start;
+	while (valid == 1 && count > 0)
+	{
+		top = stack[--count];
+		for (node = top.node; valid == 1 && node != NULL; node = node->left)
+		{
+			valid = rb_check_node(node, top.parent, top.lo, top.hi);
+			top.blacks += RB_COLOR(node) == BLACK;
+			if (valid && count == size)
+			{
+				tmp = realloc(stack, sizeof(*stack) * size * 2);
+				valid = tmp != NULL ? 1 : -1;
+				if (tmp != NULL)
+					stack = tmp, size *= 2;
+			}
+			if (valid == 1 && node->right != NULL)
+				stack[count++] = (rb_check_t){node->right, node,
+					RB_KEY(node), top.hi, top.blacks};
+			else if (valid == 1 && *height == 0)
+				*height = top.blacks;
+			else if (valid == 1)
+				valid = *height == top.blacks;
+			top.parent = node, top.hi = RB_KEY(node);
+		}
+		if (valid == 1 && *height == 0)
+			*height = top.blacks;
+		else if (valid == 1)
+			valid = *height == top.blacks;
+	}
+	free(stack);
+	return (valid);
+}
+
+/**
+ * rb_validate_worker - check every subtree of a thread's share
+ *
+ * @share: share to check
+ */
+void rb_validate_worker(rb_validate_t *share)
+{
+	size_t i;
+
+	for (i = share->first; i < share->count && share->valid == 1;
+		i += share->stride)
+		share->valid = rb_check_subtree(share->checks + i, &share->height);
+}
+
+/**
+ * rb_validate_split - check the top levels of a tree until enough
+ * independent subtrees are left to keep every thread busy
+ *
+ * @checks: subtrees left to check, replaced by the level below
+ * @count: number of subtrees in @checks, updated
+ * @want: number of subtrees to stop at
+ * @height: black nodes on every path to a leaf, as in rb_check_subtree
+ *
+ * Return: 1 if the levels checked are valid, 0 otherwise. When memory runs
+ * out, the subtrees not split yet are left to check as they are
+ */
+static int rb_validate_split(rb_check_t **checks, size_t *count,
+	size_t want, size_t *height)
+{
+	rb_check_t *next, *check;
+	const rb_tree_t *child;
+	size_t i, found, blacks;
+	long long key;
+	int dir, valid = 1;
+
+	while (valid && *count > 0 && *count < want)
+	{
+		next = malloc(sizeof(*next) * *count * 2);
+		if (next == NULL)
+			return (1);
+		for (i = found = 0; i < *count && valid; i++)
+		{
+			check = *checks + i;
+			valid = rb_check_node(check->node, check->parent, check->lo,
+				check->hi);
+			blacks = check->blacks + (RB_COLOR(check->node) == BLACK);
+			key = RB_KEY(check->node);
+			for (dir = 0; dir < 2 && valid; dir++)
+			{
+				child = RB_LINK(check->node, dir);
+				if (child != NULL)
+					next[found++] = (rb_check_t){child, check->node,
+						dir ? key : check->lo, dir ? check->hi : key,
+						blacks};
+				else if (*height == 0)
+					*height = blacks;
+				else
+					valid = *height == blacks;
+			}
+		}
+		free(*checks);
+		*checks = next;
+		*count = found;
+	}
+	return (valid);
+}
+
+/**
+ * rb_validator_full - check every property of an RB tree on the threads of
+ * a validator
+ *
+ * The top of the tree is checked first, until there are RB_VALIDATE_JOBS
+ * independent subtrees per thread, then the threads check the subtrees.
+ * Nothing is recursive, so deep or corrupted trees are fine.
+ *
+ * @validator: validator whose threads check the tree
+ * @tree: root of the tree
+ *
+ * Return: 1 if the tree is valid, 0 if it isn't or is empty, -1 if memory
+ * ran out
+ */
+int rb_validator_full(rb_validator_t *validator, const rb_tree_t *tree)
+{
+	rb_validate_t *share;
+	rb_check_t *checks;
+	size_t i, count = 1, height = 0, threads = validator->threads;
+	int valid = 1;
+
+	if (tree == NULL || RB_PARENT(tree) != NULL || RB_COLOR(tree) != BLACK)
+		return (0);
+	checks = malloc(sizeof(*checks));
+	if (checks == NULL)
+		return (-1);
+	checks[0] = (rb_check_t){tree, NULL, LLONG_MIN, LLONG_MAX, 0};
+	if (threads > 1)
+		valid = rb_validate_split(&checks, &count,
+			threads * RB_VALIDATE_JOBS, &height);
+	for (i = 0; valid == 1 && i < threads; i++)
+	{
+		/* Waiting workers may read @validator, so it is left alone */
+		share = validator->shares + i;
+		share->checks = checks, share->count = count, share->first = i;
+		share->stride = threads, share->height = height, share->valid = 1;
+	}
+	if (valid == 1 && count > 0)
+		rb_validator_run(validator);
+	for (i = 0; valid == 1 && i < threads; i++)
+	{
+		if (validator->shares[i].valid != 1)
+			valid = validator->shares[i].valid;
+		else if (height == 0)
+			height = validator->shares[i].height;
+		else if (validator->shares[i].height != 0 &&
+			validator->shares[i].height != height)
+			valid = 0;
+	}
+	free(checks);
+	return (valid);
+}
+
+/**
+ * rb_tree_validate - check every property of an RB tree: colors, black
+ * heights, key order, parent pointers and augmented fields
+ *
+ * The threads only live for this one check. To check a tree again and
+ * again, keep an rb_validator_t, whose threads stay up until it is
+ * destroyed.
+ *
+ * @tree: root of the tree
+ * @threads: number of threads to use, 0 for one per online CPU
+ *
+ * Return: 1 if the tree is valid, 0 if it isn't or is empty, -1 if memory
+ * ran out
+ */
+int rb_tree_validate(const rb_tree_t *tree, size_t threads)
+{
+	rb_validator_t *validator;
+	int valid;
+
+	if (tree == NULL || RB_PARENT(tree) != NULL || RB_COLOR(tree) != BLACK)
+		return (0);
+	validator = rb_validator_create(threads);
+	if (validator == NULL)
+		return (-1);
+	valid = rb_validator_full(validator, tree);
+	rb_validator_destroy(validator);
+	return (valid);
+}
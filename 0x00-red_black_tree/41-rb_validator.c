@@ -0,0 +1,106 @@
+#include <unistd.h>
+#include "rb_trees.h"
+
+/**
+ * rb_validator_create - create an incremental validator. Its first check
+ * covers the whole tree
+ *
+ * The threads of full checks are started here and wait between checks,
+ * so a check doesn't pay for starting them.
+ *
+ * @threads: number of threads for full checks, 0 for one per online CPU
+ *
+ * Return: the validator, NULL on failure
+ */
+rb_validator_t *rb_validator_create(size_t threads)
+{
+	rb_validator_t *validator;
+	size_t i;
+
+	validator = malloc(sizeof(*validator));
+	if (validator == NULL)
+		return (NULL);
+	if (threads == 0)
+		threads = sysconf(_SC_NPROCESSORS_ONLN) > 0 ?
+			(size_t)sysconf(_SC_NPROCESSORS_ONLN) : 1;
+	validator->keys = malloc(sizeof(*validator->keys) * RB_VALIDATOR_PATHS);
+	validator->shares = calloc(threads, sizeof(*validator->shares));
+	if (validator->keys == NULL || validator->shares == NULL)
+	{
+		free(validator->keys);
+		free(validator->shares);
+		free(validator);
+		return (NULL);
+	}
+	for (i = 0; i < threads; i++)
+		validator->shares[i].validator = validator;
+	validator->count = 0;
+	validator->threads = threads;
+	validator->full = 1;
+	rb_validator_start(validator);
+	return (validator);
+}
+
+/**
+ * rb_validator_destroy - stop the threads of an incremental validator and
+ * free it
+ *
+ * @validator: validator to free, may be NULL
+ */
+void rb_validator_destroy(rb_validator_t *validator)
+{
+	if (validator == NULL)
+		return;
+	rb_validator_stop(validator);
+	free(validator->keys);
+	free(validator->shares);
+	free(validator);
+}
+
+/**
+ * rb_validator_touch - record a key inserted into or removed from the tree
+ * a validator watches, so the next check covers its search path
+ *
+ * Past RB_VALIDATOR_PATHS keys, checking them all costs about as much as
+ * checking the whole tree, so the next check becomes a full one.
+ *
+ * @validator: validator of the tree
+ * @n: key inserted or removed
+ */
+void rb_validator_touch(rb_validator_t *validator, int n)
+{
+	if (validator->full)
+		return;
+	if (validator->count == RB_VALIDATOR_PATHS)
+		validator->full = 1;
+	else
+		validator->keys[validator->count++] = n;
+}
+
+/**
+ * rb_validator_check - check the parts of a tree changed since the last
+ * check, or the whole tree if it is the first check, if too many keys
+ * were touched, if @validator->full was set or if the last check failed
+ *
+ * @validator: validator of the tree
+ * @tree: root of the tree
+ *
+ * Return: 1 if the tree is valid, 0 if it isn't or is empty, -1 if memory
+ * ran out
+ */
+int rb_validator_check(rb_validator_t *validator, const rb_tree_t *tree)
+{
+	size_t i;
+	int valid = 1;
+
+	if (validator->full)
+		valid = rb_validator_full(validator, tree);
+	else if (tree == NULL || RB_PARENT(tree) != NULL ||
+		RB_COLOR(tree) != BLACK)
+		valid = 0;
+	for (i = 0; valid == 1 && !validator->full && i < validator->count; i++)
+		valid = rb_check_path(tree, validator->keys[i]);
+	validator->count = 0;
+	validator->full = valid != 1;
+	return (valid);
+}
@@ -0,0 +1,37 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "rb_trees.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree = NULL;
+    int *keys, i;
+    size_t added;
+
+    keys = malloc(sizeof(*keys) * 900000);
+    if (!keys)
+        return (1);
+    for (i = 0; i < 900000; i++)
+        keys[i] = (int)((i * 7919L) % 1000003);
+
+    added = rb_tree_insert_batch(&tree, keys, 100000);
+    printf("Empty tree, rebuilt: added %lu, valid %d\n",
+        (unsigned long)added, rb_tree_is_valid(tree));
+    added = rb_tree_insert_batch(&tree, keys + 50000, 10000);
+    printf("Duplicates only: added %lu\n", (unsigned long)added);
+    added = rb_tree_insert_batch(&tree, keys + 100000, 10000);
+    printf("Small batch, hinted: added %lu, valid %d\n",
+        (unsigned long)added, rb_tree_is_valid(tree));
+    added = rb_tree_insert_batch(&tree, keys, 900000);
+    printf("Large batch, rebuilt: added %lu, valid %d\n",
+        (unsigned long)added, rb_tree_is_valid(tree));
+
+    free(keys);
+    rb_tree_delete(tree);
+    return (0);
+}
@@ -0,0 +1,73 @@
+#include <string.h>
+#include "rb_trees.h"
+
+/**
+ * rb_batch_size - count the nodes of a tree, giving up past a limit
+ *
+ * @tree: root of the tree
+ * @limit: count to stop at
+ *
+ * Return: number of nodes, or @limit if there are at least that many. The
+ * walk costs O(log(n) + @limit)
+ */
+static size_t rb_batch_size(rb_tree_t *tree, size_t limit)
+{
+	size_t size = 0;
+
+	while (tree != NULL && tree->left != NULL)
+		tree = tree->left;
+	for (; tree != NULL && size < limit; tree = rb_tree_next(tree))
+		size++;
+	return (size);
+}
+
+/**
+ * rb_tree_insert_batch - insert a batch of keys into an RB tree
+ *
+ * The batch is sorted first. When it holds at least RB_BATCH_REBUILD times
+ * as many keys as the tree has nodes, the tree's keys and the batch are
+ * merged in one linear pass and the tree is relinked perfectly balanced,
+ * reusing its nodes. Otherwise each key is inserted with a hint on the
+ * previous one, linking keys that fall between it and its neighbors
+ * directly, which stays cheaper than touching every node until the batch
+ * is about that large.
+ *
+ * @tree: pointer to root node of tree
+ * @keys: keys to insert, in any order, duplicates allowed
+ * @n: number of keys
+ *
+ * Return: number of nodes added, or in multiset mode number of occurrences
+ * added. Fewer than expected only when memory runs out
+ */
+size_t rb_tree_insert_batch(rb_tree_t **tree, const int *keys, size_t n)
+{
+	rb_hint_t hint = {NULL, {NULL, NULL}, 0};
+	rb_tree_t *node;
+	size_t i, added = 0, size, limit;
+	int *sorted;
+
+	if (tree == NULL || keys == NULL || n == 0)
+		return (0);
+	sorted = malloc(sizeof(*sorted) * n);
+	if (sorted == NULL)
+		return (0);
+	memcpy(sorted, keys, sizeof(*sorted) * n);
+	rb_sort_keys(sorted, n);
+	limit = n / RB_BATCH_REBUILD + 1;
+	size = rb_batch_size(*tree, limit);
+	node = size < limit ?
+		rb_batch_rebuild(*tree, size, sorted, n, &added) : NULL;
+	if (node != NULL)
+		*tree = node;
+	else
+	{
+		/* No rebuild, or it ran out of memory */
+		for (i = 0; i < n; i++)
+		{
+			node = rb_tree_insert_hint(tree, &hint, sorted[i]);
+			added += node != NULL;
+		}
+	}
+	free(sorted);
+	return (added);
+}
@@ -0,0 +1,172 @@
+#include "rb_trees.h"
+
+/**
+ * rb_batch_fresh - find the keys of a sorted batch missing from a tree
+ *
+ * @tree_keys: keys of the tree in order, as given by RB_KEY
+ * @size: number of keys of the tree
+ * @keys: ascending keys of the batch
+ * @n: number of keys
+ * @fresh_keys: array receiving the missing keys, without duplicates
+ *
+ * Return: number of missing keys
+ */
+static size_t rb_batch_fresh(const long long *tree_keys, size_t size,
+	const int *keys, size_t n, int *fresh_keys)
+{
+	size_t i = 0, j, made = 0;
+
+	for (j = 0; j < n; j++)
+	{
+		while (i < size && tree_keys[i] < RB_KEY_OF(keys[j]))
+			i++;
+		if ((i == size || tree_keys[i] != RB_KEY_OF(keys[j])) &&
+			(j == 0 || keys[j] != keys[j - 1]))
+			fresh_keys[made++] = keys[j];
+	}
+	return (made);
+}
+
+/**
+ * rb_batch_merge - merge new nodes into the array of the nodes of a tree,
+ * in place, from the end
+ *
+ * In multiset mode the extra occurrences in the batch are added to their
+ * node's count.
+ *
+ * @nodes: nodes of the tree in order, with room for the new nodes after
+ * @tree_keys: keys of the nodes of the tree, as given by RB_KEY
+ * @size: number of nodes of the tree
+ * @keys: ascending keys of the batch
+ * @n: number of keys
+ * @fresh: one new node per key missing from the tree, largest key first,
+ * chained through their right links
+ * @made: number of new nodes
+ */
+static void rb_batch_merge(rb_tree_t **nodes, const long long *tree_keys,
+	size_t size, const int *keys, size_t n, rb_tree_t *fresh, size_t made)
+{
+	rb_tree_t **out = nodes + size + made, *add;
+	long long key;
+
+	while (n > 0)
+	{
+		if (size > 0 && tree_keys[size - 1] >= RB_KEY_OF(keys[n - 1]))
+		{
+			key = tree_keys[--size];
+			add = nodes[size];
+		}
+		else
+		{
+			key = RB_KEY_OF(keys[n - 1]);
+			n--;
+			add = fresh;
+			fresh = fresh->right;
+		}
+		*--out = add;
+		for (; n > 0 && RB_KEY_OF(keys[n - 1]) == key; n--)
+		{
+#ifdef RB_MULTISET
+			add->count++;
+#endif
+		}
+	}
+}
+
+/**
+ * rb_batch_link - relink nodes into a perfectly balanced subtree, colored
+ * like the trees of sorted_array_to_rb_tree
+ *
+ * @nodes: nodes of the subtree, in order
+ * @size: number of nodes
+ * @parent: parent of the subtree root
+ * @depth: depth of the subtree root
+ * @red_depth: depth whose nodes are colored red
+ *
+ * Return: root of the subtree, NULL if @size is 0
+ */
+static rb_tree_t *rb_batch_link(rb_tree_t **nodes, size_t size,
+	rb_tree_t *parent, size_t depth, size_t red_depth)
+{
+	rb_tree_t *node;
+	size_t mid = size / 2;
+
+	if (size == 0)
+		return (NULL);
+	node = nodes[mid];
+	RB_SET_PARENT_COLOR(node, parent,
+		(depth && depth == red_depth) ? RED : BLACK);
+	node->left = rb_batch_link(nodes, mid, node, depth + 1, red_depth);
+	node->right = rb_batch_link(nodes + mid + 1, size - mid - 1, node,
+		depth + 1, red_depth);
+	RB_AUGMENT(node);
+	return (node);
+}
+
+/**
+ * rb_batch_rebuild - merge a sorted batch of keys into a tree and relink
+ * the result perfectly balanced, in O(size + n)
+ *
+ * The tree is walked once to list its nodes and keys, every other pass
+ * runs over arrays. The nodes of the tree are reused, so their payload
+ * (occurrence counts, interval ends) is kept. Every allocation is done
+ * before the tree is touched, so on failure the tree is left as it was.
+ *
+ * @tree: root of the tree, may be NULL
+ * @size: number of nodes of the tree
+ * @keys: ascending keys of the batch
+ * @n: number of keys
+ * @added: set to the number of nodes added, or in multiset mode to the
+ * number of occurrences added
+ *
+ * Return: root of the new tree, NULL on failure
+ */
+rb_tree_t *rb_batch_rebuild(rb_tree_t *tree, size_t size, const int *keys,
+	size_t n, size_t *added)
+{
+	rb_tree_t **nodes, *fresh = NULL, *node = tree, *root = NULL;
+	size_t made = 0, i, red_depth;
+	long long *tree_keys;
+	int *fresh_keys;
+
+	nodes = malloc(sizeof(*nodes) * (size + n));
+	tree_keys = malloc(sizeof(*tree_keys) * (size + 1));
+	fresh_keys = malloc(sizeof(*fresh_keys) * n);
+	if (nodes != NULL && tree_keys != NULL && fresh_keys != NULL)
+	{
+		while (node != NULL && node->left != NULL)
+			node = node->left;
+		for (i = 0; i < size; i++, node = rb_tree_next(node))
+			nodes[i] = node, tree_keys[i] = RB_KEY(node);
+		made = rb_batch_fresh(tree_keys, size, keys, n, fresh_keys);
+	}
+	for (i = 0; i < made; i++)
+	{
+		node = rb_tree_node(NULL, fresh_keys[i], RED);
+		if (node == NULL)
+			break;
+		node->right = fresh, fresh = node;
+	}
+	if (nodes != NULL && tree_keys != NULL && fresh_keys != NULL &&
+		i == made)
+	{
+		rb_batch_merge(nodes, tree_keys, size, keys, n, fresh, made);
+		for (red_depth = 0, i = size + made; i > 1; i >>= 1)
+			red_depth++;
+		root = rb_batch_link(nodes, size + made, NULL, 0, red_depth);
+#ifdef RB_MULTISET
+		*added = n;
+#else
+		*added = made;
+#endif
+	}
+	for (; root == NULL && fresh != NULL; fresh = node)
+	{
+		node = fresh->right;
+		free(fresh);
+	}
+	free(nodes);
+	free(tree_keys);
+	free(fresh_keys);
+	return (root);
+}
@@ -0,0 +1,72 @@
+#include <string.h>
+#include "rb_trees.h"
+
+/**
+ * compare_int - qsort comparator for integers
+ *
+ * @a: pointer to first integer
+ * @b: pointer to second integer
+ *
+ * Return: negative, zero or positive as @a is less, equal or greater than @b
+ */
+static int compare_int(const void *a, const void *b)
+{
+	int x = *(const int *)a, y = *(const int *)b;
+
+	return ((x > y) - (x < y));
+}
+
+/**
+ * rb_sort_keys - sort keys in ascending order
+ *
+ * Uses a least significant digit radix sort on bytes, in O(n), skipping
+ * the bytes that are the same in every key. Small arrays, and arrays for
+ * which the scratch buffer can't be allocated, go through qsort.
+ *
+ * @keys: keys to sort
+ * @n: number of keys
+ */
+void rb_sort_keys(int *keys, size_t n)
+{
+	size_t counts[4][256], pos, i;
+	uint32_t *src = (uint32_t *)keys, *dst = NULL, *tmp, digit;
+	int shift;
+
+	if (n >= RB_SORT_RADIX)
+		dst = malloc(sizeof(*dst) * n);
+	if (dst == NULL)
+	{
+		qsort(keys, n, sizeof(*keys), compare_int);
+		return;
+	}
+	memset(counts, 0, sizeof(counts));
+	/* Flip the sign bit so negative keys sort first as unsigned */
+	for (i = 0; i < n; i++)
+	{
+		src[i] ^= 0x80000000u;
+		for (shift = 0; shift < 32; shift += 8)
+			counts[shift / 8][(src[i] >> shift) & 0xff]++;
+	}
+	for (shift = 0; shift < 32; shift += 8)
+	{
+		if (counts[shift / 8][(src[0] >> shift) & 0xff] == n)
+			continue;
+		for (digit = 0, pos = 0; digit < 256; digit++)
+		{
+			i = counts[shift / 8][digit];
+			counts[shift / 8][digit] = pos;
+			pos += i;
+		}
+		for (i = 0; i < n; i++)
+			dst[counts[shift / 8][(src[i] >> shift) & 0xff]++] = src[i];
+		tmp = src, src = dst, dst = tmp;
+	}
+	for (i = 0; i < n; i++)
+		src[i] ^= 0x80000000u;
+	if (src != (uint32_t *)keys)
+	{
+		memcpy(keys, src, sizeof(*keys) * n);
+		dst = src;
+	}
+	free(dst);
+}
@@ -0,0 +1,26 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "rb_trees.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree = NULL;
+    int i;
+
+    for (i = 0; i < 20; i++)
+        if (!rb_tree_insert(&tree, (i * 37) % 101))
+            return (1);
+    if (rb_tree_dump(tree, stdout, RB_DUMP_LEVELS, 0) == -1)
+        return (1);
+    printf("\nTop 2 levels as JSON:\n");
+    rb_tree_dump(tree, stdout, RB_DUMP_JSON, 2);
+    printf("\nTop 3 levels as Graphviz:\n");
+    rb_tree_dump(tree, stdout, RB_DUMP_DOT, 3);
+    rb_tree_delete(tree);
+    return (0);
+}
@@ -0,0 +1,127 @@
+#include <string.h>
+#include "rb_trees.h"
+
+/**
+ * rb_dump_walk - visit a tree in preorder, without recursion nor stack
+ *
+ * The walk follows parent pointers back up, so it takes constant memory
+ * whatever the shape of the tree. A walk that isn't cut short also counts
+ * the nodes for the summary of the dump.
+ *
+ * @dump: state of the dump, @dump->depth is kept up to date
+ * @tree: root of the tree
+ * @max: depth below which the walk doesn't go
+ * @visit: called when entering a node with @leave 0 and when leaving it
+ * with @leave 1, may be NULL
+ */
+static void rb_dump_walk(rb_dump_t *dump, const rb_tree_t *tree, size_t max,
+	void (*visit)(rb_dump_t *dump, const rb_tree_t *node, int leave))
+{
+	const rb_tree_t *node = tree, *from = RB_PARENT(tree), *next = NULL;
+
+	dump->depth = 0;
+	while (node != RB_PARENT(tree))
+	{
+		if (from == RB_PARENT(node))
+		{
+			if (max == SIZE_MAX)
+			{
+				dump->nodes++;
+				dump->red += IS_RED(node);
+				if (dump->depth > dump->height)
+					dump->height = dump->depth;
+				dump->hidden += dump->depth >= dump->levels;
+			}
+			if (visit != NULL)
+				visit(dump, node, 0);
+			next = node->left != NULL ? node->left : node->right;
+		}
+		else
+			next = from == node->left ? node->right : NULL;
+		from = node;
+		if (next != NULL && dump->depth < max)
+			node = next, dump->depth++;
+		else
+		{
+			if (visit != NULL)
+				visit(dump, node, 1);
+			node = RB_PARENT(node), dump->depth--;
+		}
+	}
+}
+
+/**
+ * rb_dump_summary - write the summary of a dump
+ *
+ * @dump: state of the dump, after a full walk
+ * @tree: root of the tree
+ * @format: output format
+ */
+static void rb_dump_summary(rb_dump_t *dump, const rb_tree_t *tree,
+	rb_dump_format_t format)
+{
+	unsigned long levels, black;
+
+	levels = tree != NULL ? dump->height + 1 : 0;
+	black = rb_black_height(tree);
+	if (format == RB_DUMP_DOT)
+		fprintf(dump->stream, "\tlabel=\"nodes %lu, red %lu, levels %lu, "
+			"black height %lu, hidden %lu\";\n}\n",
+			(unsigned long)dump->nodes, (unsigned long)dump->red, levels,
+			black, (unsigned long)dump->hidden);
+	else if (format == RB_DUMP_JSON)
+		fprintf(dump->stream, ",\"nodes\":%lu,\"red\":%lu,\"levels\":%lu,"
+			"\"black_height\":%lu,\"hidden\":%lu}\n",
+			(unsigned long)dump->nodes, (unsigned long)dump->red, levels,
+			black, (unsigned long)dump->hidden);
+	else
+		fprintf(dump->stream, "nodes %lu, red %lu, levels %lu, "
+			"black height %lu, hidden %lu\n",
+			(unsigned long)dump->nodes, (unsigned long)dump->red, levels,
+			black, (unsigned long)dump->hidden);
+}
+
+/**
+ * rb_tree_dump - write an RB tree to a stream, in constant memory
+ *
+ * RB_DUMP_DOT and RB_DUMP_JSON are written in one walk of the tree.
+ * RB_DUMP_LEVELS writes one line per level, each from its own walk down to
+ * that level, which costs O(n log(n)) for a balanced tree. When @levels is
+ * not 0, only the top @levels levels are written, each subtree below them
+ * is replaced by its number of nodes, and every node is still counted in
+ * the summary that ends the dump.
+ *
+ * @tree: root of the tree, may be NULL
+ * @stream: stream to write to
+ * @format: output format
+ * @levels: number of levels to write, 0 for all of them
+ *
+ * Return: 0 on success, -1 if writing failed
+ */
+int rb_tree_dump(const rb_tree_t *tree, FILE *stream, rb_dump_format_t format,
+	size_t levels)
+{
+	rb_dump_t dump;
+
+	memset(&dump, 0, sizeof(dump));
+	dump.stream = stream;
+	dump.levels = levels != 0 ? levels : SIZE_MAX;
+	if (format == RB_DUMP_DOT)
+		fprintf(stream, "digraph rb {\n\tnode [style=filled, "
+			"fontcolor=white];\n");
+	else if (format == RB_DUMP_JSON)
+		fprintf(stream, "{\"root\":%s", tree != NULL ? "" : "null");
+	if (tree != NULL)
+		rb_dump_walk(&dump, tree, SIZE_MAX, format == RB_DUMP_DOT ?
+			rb_dump_dot : format == RB_DUMP_JSON ? rb_dump_json : NULL);
+	for (dump.target = 0; format == RB_DUMP_LEVELS && tree != NULL &&
+		dump.target <= dump.height && dump.target < dump.levels;
+		dump.target++)
+	{
+		fprintf(stream, "%lu:", (unsigned long)dump.target);
+		rb_dump_walk(&dump, tree, dump.target, rb_dump_level);
+		fprintf(stream, "\n");
+	}
+	rb_dump_summary(&dump, tree, format);
+	return (ferror(stream) ? -1 : 0);
+}
@@ -0,0 +1,80 @@
+#include "rb_trees.h"
+
+/**
+ * rb_dump_level - write the nodes of the level a pass of RB_DUMP_LEVELS
+ * is printing
+ *
+ * @dump: state of the dump
+ * @node: node visited
+ * @leave: 0 when entering @node, 1 when leaving it
+ */
+void rb_dump_level(rb_dump_t *dump, const rb_tree_t *node, int leave)
+{
+	if (leave || dump->depth != dump->target)
+		return;
+	fprintf(dump->stream, " %c(%d)", RB_COLOR(node) == RED ? 'R' : 'B',
+		node->n);
+}
+
+/**
+ * rb_dump_dot - write a node and the edge from its parent as Graphviz. A
+ * subtree below the levels shown becomes a single box holding its size
+ *
+ * Keys are unique in a tree, so they name the nodes.
+ *
+ * @dump: state of the dump
+ * @node: node visited
+ * @leave: 0 when entering @node, 1 when leaving it
+ */
+void rb_dump_dot(rb_dump_t *dump, const rb_tree_t *node, int leave)
+{
+	if (dump->depth < dump->levels && !leave)
+	{
+		fprintf(dump->stream, "\t\"%d\" [fillcolor=%s];\n", node->n,
+			RB_COLOR(node) == RED ? "red" : "black");
+		if (dump->depth > 0)
+			fprintf(dump->stream, "\t\"%d\" -> \"%d\";\n",
+				RB_PARENT(node)->n, node->n);
+	}
+	else if (dump->depth == dump->levels && !leave)
+		dump->below = dump->hidden - 1;
+	else if (dump->depth == dump->levels)
+		fprintf(dump->stream, "\t\"+%d\" [shape=box, fillcolor=gray, "
+			"label=\"%lu more\"];\n\t\"%d\" -> \"+%d\";\n", node->n,
+			(unsigned long)(dump->hidden - dump->below),
+			RB_PARENT(node)->n, node->n);
+}
+
+/**
+ * rb_dump_json - write a node as a JSON object nested in its parent's. A
+ * subtree below the levels shown becomes {"hidden": size}
+ *
+ * @dump: state of the dump
+ * @node: node visited
+ * @leave: 0 when entering @node, 1 when leaving it
+ */
+void rb_dump_json(rb_dump_t *dump, const rb_tree_t *node, int leave)
+{
+	const char *side = "";
+
+	if (dump->depth > dump->levels)
+		return;
+	if (leave)
+	{
+		if (dump->depth == dump->levels)
+			fprintf(dump->stream, "%lu",
+				(unsigned long)(dump->hidden - dump->below));
+		fprintf(dump->stream, "}");
+		return;
+	}
+	if (dump->depth > 0)
+		side = RB_PARENT(node)->left == node ? ",\"left\":" : ",\"right\":";
+	if (dump->depth == dump->levels)
+	{
+		dump->below = dump->hidden - 1;
+		fprintf(dump->stream, "%s{\"hidden\":", side);
+	}
+	else
+		fprintf(dump->stream, "%s{\"n\":%d,\"color\":\"%s\"", side, node->n,
+			RB_COLOR(node) == RED ? "red" : "black");
+}
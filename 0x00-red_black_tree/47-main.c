@@ -0,0 +1,44 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "rb_trees.h"
+
+/**
+ * print_usage - Prints the measurements of a tree
+ *
+ * @name: Name of the tree
+ * @usage: Measurements to print
+ */
+static void print_usage(const char *name, rb_usage_t usage)
+{
+    printf("%s: %lu nodes, height %lu, black height %lu, %lu bytes, "
+        "average depth %.2f\n", name, (unsigned long)usage.nodes,
+        (unsigned long)usage.height, (unsigned long)usage.black_height,
+        (unsigned long)usage.bytes, usage.average_depth);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree = NULL;
+    rb_arena_t *arena;
+    int i;
+
+    for (i = 0; i < 10000; i++)
+        if (!rb_tree_insert(&tree, (i * 7919) % 10007))
+            return (1);
+    for (i = 0; i < 10000; i += 2)
+        tree = rb_tree_remove(tree, (i * 7919) % 10007);
+    print_usage("malloc", rb_tree_usage(tree, NULL));
+
+    tree = rb_tree_compact(NULL, &arena, tree, RB_IN_ORDER);
+    if (!arena)
+        return (1);
+    print_usage("compacted", rb_tree_usage(tree, arena));
+    printf("Valid: %d\n", rb_tree_is_valid(tree));
+    rb_arena_destroy(arena);
+    return (0);
+}
@@ -0,0 +1,78 @@
+#include "rb_trees.h"
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/**
+ * rb_chunk_bytes - measure the memory malloc took for a block, its header
+ * and padding included
+ *
+ * @ptr: block returned by malloc
+ * @size: size asked for
+ *
+ * Return: number of bytes taken. Outside glibc, this is an estimate for a
+ * dlmalloc-style allocator
+ */
+static size_t rb_chunk_bytes(void *ptr, size_t size)
+{
+#ifdef __GLIBC__
+	(void)size;
+	return (malloc_usable_size(ptr) + sizeof(size_t));
+#else
+	size_t align = 2 * sizeof(size_t);
+
+	(void)ptr;
+	size = (size + sizeof(size_t) + align - 1) / align * align;
+	return (size < 2 * align ? 2 * align : size);
+#endif
+}
+
+/**
+ * rb_tree_usage - measure the shape of an RB tree and the memory it takes
+ *
+ * The nodes are walked through their parent pointers, in constant memory.
+ * Nodes from malloc are measured one by one. Nodes from an arena are
+ * measured by the slabs of the arena, which also hold its free nodes and
+ * any other tree built from it.
+ *
+ * @tree: root of the tree, may be NULL
+ * @arena: arena the nodes came from, or NULL if they came from malloc
+ *
+ * Return: the measurements
+ */
+rb_usage_t rb_tree_usage(const rb_tree_t *tree, const rb_arena_t *arena)
+{
+	rb_usage_t usage = {0, 0, 0, 0, 0.0};
+	const rb_tree_t *node = tree, *from, *next;
+	const rb_slab_t *slab;
+	size_t depth = 0, total = 0;
+
+	from = tree != NULL ? RB_PARENT(tree) : NULL;
+	while (tree != NULL && node != RB_PARENT(tree))
+	{
+		if (from == RB_PARENT(node))
+		{
+			usage.nodes++;
+			total += depth;
+			if (depth + 1 > usage.height)
+				usage.height = depth + 1;
+			if (arena == NULL)
+				usage.bytes += rb_chunk_bytes((void *)node, sizeof(*node));
+			next = node->left != NULL ? node->left : node->right;
+		}
+		else
+			next = from == node->left ? node->right : NULL;
+		from = node;
+		if (next != NULL)
+			node = next, depth++;
+		else
+			node = RB_PARENT(node), depth--;
+	}
+	for (slab = arena != NULL ? arena->slabs : NULL; slab; slab = slab->next)
+		usage.bytes += rb_chunk_bytes((void *)slab, sizeof(*slab) +
+			sizeof(rb_tree_t) * arena->slab_size);
+	usage.black_height = rb_black_height(tree);
+	if (usage.nodes > 0)
+		usage.average_depth = (double)total / usage.nodes;
+	return (usage);
+}
@@ -0,0 +1,115 @@
+#include "rb_trees.h"
+
+/**
+ * rb_compact_in_order - copy a subtree into an arena, in sorted order
+ *
+ * @to: arena to copy into, handing out consecutive nodes
+ * @old: root of the subtree to copy
+ * @parent: parent of the copy
+ *
+ * Return: root of the copy. The arena holds enough nodes for the whole
+ * tree, so this doesn't fail
+ */
+static rb_tree_t *rb_compact_in_order(rb_arena_t *to, const rb_tree_t *old,
+	rb_tree_t *parent)
+{
+	rb_tree_t *left, *node;
+
+	if (old == NULL)
+		return (NULL);
+	left = rb_compact_in_order(to, old->left, NULL);
+	node = rb_arena_node(to, NULL, 0, RED);
+	*node = *old;
+	RB_SET_PARENT(node, parent);
+	node->left = left;
+	if (left != NULL)
+		RB_SET_PARENT(left, node);
+	node->right = rb_compact_in_order(to, old->right, node);
+	return (node);
+}
+
+/**
+ * rb_compact_breadth_first - copy a tree into an arena, level by level
+ *
+ * The copies are their own queue: each copy starts with the child links
+ * of its original, and scanning the copies in order replaces those links
+ * with copies of the children, appended behind the others.
+ *
+ * @to: arena to copy into, handing out consecutive nodes
+ * @old: root of the tree to copy
+ *
+ * Return: root of the copy. The arena holds enough nodes for the whole
+ * tree, so this doesn't fail
+ */
+static rb_tree_t *rb_compact_breadth_first(rb_arena_t *to,
+	const rb_tree_t *old)
+{
+	rb_tree_t *root, *node, *child;
+	size_t i, count = 1;
+	int dir;
+
+	root = rb_arena_node(to, NULL, 0, RED);
+	*root = *old;
+	RB_SET_PARENT(root, NULL);
+	for (i = 0; i < count; i++)
+	{
+		node = root + i;
+		for (dir = 0; dir < 2; dir++)
+		{
+			if (RB_LINK(node, dir) == NULL)
+				continue;
+			child = rb_arena_node(to, NULL, 0, RED);
+			*child = *RB_LINK(node, dir);
+			RB_SET_PARENT(child, node);
+			RB_LINK(node, dir) = child;
+			count++;
+		}
+	}
+	return (root);
+}
+
+/**
+ * rb_tree_compact - move the nodes of an RB tree into one block of memory,
+ * laid out in sorted or breadth-first order
+ *
+ * After many inserts and removals, nodes are scattered across the heap
+ * and walks jump between pages. The copy puts neighbors in the chosen
+ * order next to each other, with no allocator header between them.
+ *
+ * @from: arena the nodes came from, or NULL if they came from malloc. The
+ * old nodes are released to it, destroy it instead if it held nothing else
+ * @to: receives the arena holding the new nodes, free the tree with
+ * rb_arena_destroy. Set to NULL if the tree is empty or on failure
+ * @tree: root of the tree
+ * @layout: order to lay the nodes out in
+ *
+ * Return: root of the compacted tree, or @tree unchanged on failure
+ */
+rb_tree_t *rb_tree_compact(rb_arena_t *from, rb_arena_t **to, rb_tree_t *tree,
+	rb_layout_t layout)
+{
+	rb_tree_t *root;
+	size_t nodes;
+
+	if (to == NULL)
+		return (tree);
+	*to = NULL;
+	nodes = rb_tree_usage(tree, from).nodes;
+	if (nodes == 0)
+		return (tree);
+	*to = rb_arena_create(nodes);
+	/* The first node carves the single slab the others come from */
+	if (*to == NULL || rb_arena_node(*to, NULL, 0, RED) == NULL)
+	{
+		rb_arena_destroy(*to);
+		*to = NULL;
+		return (tree);
+	}
+	(*to)->used = 0;
+	if (layout == RB_BREADTH_FIRST)
+		root = rb_compact_breadth_first(*to, tree);
+	else
+		root = rb_compact_in_order(*to, tree, NULL);
+	rb_tree_delete_arena(from, tree);
+	return (root);
+}
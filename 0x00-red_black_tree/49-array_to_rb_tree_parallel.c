@@ -0,0 +1,201 @@
+#include <unistd.h>
+#include "rb_trees.h"
+
+/**
+ * rb_build_sample - choose the splitters between the buckets of a
+ * parallel build
+ *
+ * RB_BUILD_SAMPLES keys per bucket are picked at pseudo-random places of
+ * the input and sorted, and every RB_BUILD_SAMPLES-th one becomes a
+ * splitter. The buckets so get about as many keys each however the keys
+ * are spread, only a key repeated in a large part of the input filling a
+ * bucket on its own. The samples are sorted in the keys of the build,
+ * RB_BUILD_MIN being larger than their number.
+ *
+ * @build: the build
+ */
+static void rb_build_sample(rb_build_t *build)
+{
+	uint64_t seed = build->size;
+	size_t i;
+
+	for (i = 0; i < RB_BUILD_BUCKETS * RB_BUILD_SAMPLES; i++)
+	{
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		build->keys[i] = build->array[(size_t)(seed >> 16) % build->size];
+	}
+	rb_sort_keys(build->keys, RB_BUILD_BUCKETS * RB_BUILD_SAMPLES);
+	for (i = 0; i < RB_BUILD_BUCKETS - 1; i++)
+		build->splitters[i] = build->keys[(i + 1) * RB_BUILD_SAMPLES];
+}
+
+/**
+ * rb_build_sort - sort and deduplicate the input of a parallel build
+ *
+ * The keys are split into RB_BUILD_BUCKETS ranges by splitters sampled
+ * from the input, each thread moving its chunk of the input to the
+ * buckets. Then each bucket is sorted on its own and its distinct keys
+ * copied out, the buckets being spread among the threads.
+ *
+ * @build: the build, its workers started
+ *
+ * Return: number of distinct keys
+ */
+static size_t rb_build_sort(rb_build_t *build)
+{
+	size_t i, t, count, offset = 0;
+
+	rb_build_sample(build);
+	rb_build_run(build, 0);
+	for (i = 0; i < RB_BUILD_BUCKETS; i++)
+	{
+		build->starts[i] = offset;
+		for (t = 0; t < build->threads; t++)
+		{
+			count = build->shares[t].counts[i];
+			build->shares[t].counts[i] = offset;
+			offset += count;
+		}
+	}
+	build->starts[RB_BUILD_BUCKETS] = offset;
+	rb_build_run(build, 1);
+	rb_build_run(build, 2);
+	for (i = 0; i < RB_BUILD_BUCKETS; i++)
+		build->firsts[i + 1] += build->firsts[i];
+	rb_build_run(build, 3);
+	return (build->firsts[RB_BUILD_BUCKETS]);
+}
+
+/**
+ * rb_build_spine - build the top levels of the tree, down to the depth
+ * where the subtrees are left to the threads
+ *
+ * The nodes get the same keys and colors as with rb_tree_build_r, so the
+ * subtrees built separately fit under them.
+ *
+ * @build: the build, the subtrees below the spine are added to its jobs
+ * @keys: strictly ascending keys of the subtree
+ * @size: number of keys, not 0
+ * @parent: parent of the subtree
+ * @depth: depth of the subtree, less than the depth of the split
+ *
+ * Return: root of the subtree, NULL on failure
+ */
+static rb_tree_t *rb_build_spine(rb_build_t *build, const int *keys,
+	size_t size, rb_tree_t *parent, size_t depth)
+{
+	rb_tree_t *node;
+	size_t mid = size / 2;
+
+	node = rb_tree_node(parent, keys[mid],
+		(depth && depth == build->red_depth) ? RED : BLACK);
+	if (node == NULL)
+		return (NULL);
+#ifdef RB_MULTISET
+	node->count = build->runs[keys + mid - build->sorted];
+#endif
+	if (depth + 1 == build->split)
+	{
+		build->jobs[build->count++] = (rb_build_job_t){keys, mid, node,
+			&node->left};
+		build->jobs[build->count++] = (rb_build_job_t){keys + mid + 1,
+			size - mid - 1, node, &node->right};
+		return (node);
+	}
+	if (mid)
+		node->left = rb_build_spine(build, keys, mid, node, depth + 1);
+	if (size - mid - 1)
+		node->right = rb_build_spine(build, keys + mid + 1,
+			size - mid - 1, node, depth + 1);
+	if ((mid && node->left == NULL) || (size - mid - 1 && node->right == NULL))
+	{
+		rb_tree_delete(node);
+		return (NULL);
+	}
+	return (node);
+}
+
+/**
+ * rb_build_augment - recompute the augmented fields of the spine, once
+ * the subtrees below it are built
+ *
+ * @node: root of the spine
+ * @depth: depth of @node
+ * @split: depth of the subtrees below the spine
+ */
+static void rb_build_augment(rb_tree_t *node, size_t depth, size_t split)
+{
+	if (node == NULL || depth == split)
+		return;
+	rb_build_augment(node->left, depth + 1, split);
+	rb_build_augment(node->right, depth + 1, split);
+	RB_AUGMENT(node);
+}
+
+/**
+ * array_to_rb_tree_parallel - convert an array to an RB tree on several
+ * threads
+ *
+ * The worker threads are started once for the whole build. The keys are
+ * sorted and deduplicated in parallel, then the top levels of the tree are
+ * built and the subtrees below them, RB_BUILD_JOBS per thread, are built
+ * concurrently. The tree is the same as the one built by
+ * array_to_rb_tree. Arrays of less than RB_BUILD_MIN keys are converted by
+ * array_to_rb_tree directly.
+ *
+ * @array: array to convert
+ * @size: size of array
+ * @threads: number of threads to use, 0 for one per online CPU
+ *
+ * Return: root node of RB-tree, NULL on failure
+ */
+rb_tree_t *array_to_rb_tree_parallel(int *array, size_t size, size_t threads)
+{
+	rb_build_t build = {0};
+	rb_tree_t *root = NULL;
+	size_t i, unique;
+
+	if (threads == 0)
+		threads = sysconf(_SC_NPROCESSORS_ONLN) > 0 ?
+			(size_t)sysconf(_SC_NPROCESSORS_ONLN) : 1;
+	if (array == NULL || threads == 1 || size < RB_BUILD_MIN)
+		return (array_to_rb_tree(array, size));
+	build.array = array, build.size = size, build.threads = threads;
+	while (((size_t)1 << build.split) < threads * RB_BUILD_JOBS)
+		build.split++;
+	build.buckets = malloc(sizeof(*build.buckets) * size);
+	build.keys = malloc(sizeof(*build.keys) * size);
+	build.sorted = malloc(sizeof(*build.sorted) * size);
+	build.shares = calloc(threads, sizeof(*build.shares));
+	build.jobs = malloc(sizeof(*build.jobs) << build.split);
+#ifdef RB_MULTISET
+	build.runs = malloc(sizeof(*build.runs) * size);
+	if (build.runs == NULL)
+		free(build.jobs), build.jobs = NULL;
+#endif
+	for (i = 0; build.shares != NULL && i < threads; i++)
+		build.shares[i].build = &build, build.shares[i].id = i;
+	if (build.buckets != NULL && build.keys != NULL && build.sorted != NULL &&
+		build.shares != NULL && build.jobs != NULL)
+	{
+		rb_build_start(&build);
+		unique = rb_build_sort(&build);
+		for (i = unique; i > 1; i >>= 1)
+			build.red_depth++;
+		root = rb_build_spine(&build, build.sorted, unique, NULL, 0);
+		if (root != NULL)
+			rb_build_run(&build, 4);
+		rb_build_stop(&build);
+	}
+	for (i = 0; root != NULL && i < build.count; i++)
+		if (build.jobs[i].size && *build.jobs[i].link == NULL)
+			rb_tree_delete(root), root = NULL;
+	rb_build_augment(root, 0, build.split);
+	free(build.buckets);
+	free(build.keys);
+	free(build.sorted);
+	free(build.runs);
+	free(build.shares);
+	free(build.jobs);
+	return (root);
+}
@@ -0,0 +1,34 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "rb_trees.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree, *node;
+    int *array, i, size = 1000000;
+    size_t count = 0;
+
+    array = malloc(sizeof(*array) * size);
+    if (!array)
+        return (1);
+    for (i = 0; i < size; i++)
+        array[i] = (int)((i * 7919L) % 500009);
+
+    tree = array_to_rb_tree_parallel(array, size, 4);
+    free(array);
+    if (!tree)
+        return (1);
+    for (node = tree; node->left; node = node->left)
+        ;
+    for (; node; node = rb_tree_next(node))
+        count++;
+    printf("Distinct keys: %lu\n", (unsigned long)count);
+    printf("Valid: %d\n", rb_tree_is_valid(tree));
+    rb_tree_delete(tree);
+    return (0);
+}
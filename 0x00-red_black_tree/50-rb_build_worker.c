@@ -0,0 +1,115 @@
+#include "rb_trees.h"
+
+/**
+ * rb_build_scan - find the bucket of each key of a thread's chunk of the
+ * input and count the keys per bucket, or move them to their buckets
+ *
+ * A key goes to the bucket after the last splitter not greater than it.
+ *
+ * @share: share of the thread
+ * @move: 0 to count, 1 to move
+ */
+static void rb_build_scan(rb_build_share_t *share, int move)
+{
+	rb_build_t *build = share->build;
+	size_t i, end, bucket, step;
+
+	i = build->size / build->threads * share->id;
+	end = share->id + 1 < build->threads ?
+		build->size / build->threads * (share->id + 1) : build->size;
+	for (; i < end; i++)
+	{
+		if (move)
+		{
+			build->keys[share->counts[build->buckets[i]]++] =
+				build->array[i];
+			continue;
+		}
+		bucket = 0;
+		for (step = RB_BUILD_BUCKETS / 2; step; step >>= 1)
+			if (build->splitters[bucket + step - 1] <= build->array[i])
+				bucket += step;
+		build->buckets[i] = bucket;
+		share->counts[bucket]++;
+	}
+}
+
+/**
+ * rb_build_bucket - sort a bucket and count its distinct keys, or copy
+ * them to their place among all the distinct keys
+ *
+ * Equal keys always land in the same bucket, so buckets never share a key.
+ *
+ * @build: the build
+ * @bucket: index of the bucket
+ * @copy: 0 to sort and count, 1 to copy
+ */
+static void rb_build_bucket(rb_build_t *build, size_t bucket, int copy)
+{
+	size_t i, start = build->starts[bucket], end = build->starts[bucket + 1];
+	size_t unique = 0, first = 0;
+	int *keys = build->keys;
+
+	if (copy)
+		first = build->firsts[bucket];
+	else
+	{
+		/* Other threads are filling in the counts of the other buckets */
+		rb_sort_keys(keys + start, end - start);
+	}
+	for (i = start; i < end; i++)
+	{
+		if (i == start || keys[i] != keys[i - 1])
+		{
+			if (copy)
+				build->sorted[first + unique] = keys[i];
+			if (copy && build->runs != NULL)
+				build->runs[first + unique] = 0;
+			unique++;
+		}
+		if (copy && build->runs != NULL)
+			build->runs[first + unique - 1]++;
+	}
+	if (!copy)
+		build->firsts[bucket + 1] = unique;
+}
+
+/**
+ * rb_build_job - build a subtree below the spine
+ *
+ * @build: the build
+ * @job: subtree to build
+ */
+static void rb_build_job(rb_build_t *build, rb_build_job_t *job)
+{
+	*job->link = rb_tree_build_r(NULL, job->keys, job->size, job->parent,
+		build->split, build->red_depth);
+#ifdef RB_MULTISET
+	if (*job->link != NULL)
+		rb_set_counts(*job->link, build->runs + (job->keys - build->sorted));
+#endif
+}
+
+/**
+ * rb_build_worker - run the current phase of a parallel build on a
+ * thread's share
+ *
+ * Phases 0 and 1 count and move the keys to their buckets, phases 2 and 3
+ * sort and copy the buckets, and phase 4 builds the subtrees.
+ *
+ * @share: share of the thread
+ */
+void rb_build_worker(rb_build_share_t *share)
+{
+	rb_build_t *build = share->build;
+	size_t i;
+
+	if (build->phase < 2)
+		rb_build_scan(share, build->phase);
+	else if (build->phase < 4)
+		for (i = share->id; i < RB_BUILD_BUCKETS; i += build->threads)
+			rb_build_bucket(build, i, build->phase == 3);
+	else
+		for (i = share->id; i < build->count; i += build->threads)
+			rb_build_job(build, build->jobs + i);
+}
@@ -0,0 +1,119 @@
+#include "rb_trees.h"
+
+/**
+ * rb_check_near - check a node next to a search path: its own properties,
+ * its children's links and the smallest and largest key of its subtrees
+ *
+ * @node: node to check
+ * @parent: node's expected parent
+ * @lo: every key of the subtree must be larger
+ * @hi: every key of the subtree must be smaller
+ * @spines: 1 to also compare the black heights of the node's children,
+ * for a node off the path whose subtrees the last changes left alone
+ *
+ * Return: 1 if the node is valid, 0 otherwise
+ */
+static int rb_check_near(const rb_tree_t *node, const rb_tree_t *parent,
+	long long lo, long long hi, int spines)
+{
+	const rb_tree_t *end;
+	int dir;
+
+	if (!rb_check_node(node, parent, lo, hi))
+		return (0);
+	if (spines && rb_black_height(node->left) !=
+		rb_black_height(node->right))
+		return (0);
+	for (dir = 0; dir < 2; dir++)
+	{
+		end = RB_LINK(node, dir);
+		if (end != NULL && (RB_PARENT(end) != node ||
+			(IS_RED(end) && IS_RED(node))))
+			return (0);
+		for (; end != NULL && end->left != NULL; end = end->left)
+			;
+		if (end != NULL && RB_KEY(end) <= (dir ? RB_KEY(node) : lo))
+			return (0);
+		end = RB_LINK(node, dir);
+		for (; end != NULL && end->right != NULL; end = end->right)
+			;
+		if (end != NULL && RB_KEY(end) >= (dir ? hi : RB_KEY(node)))
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * rb_check_walk - check the search path of a key and the nodes next to it
+ *
+ * The path goes left on a node holding the key, so it continues down to
+ * the key's in-order predecessor. Black heights are computed bottom-up
+ * along the path, each compared to the black height of the subtree off
+ * the path at the same level.
+ *
+ * @tree: root of the tree
+ * @key: key whose search path to check, as given by RB_KEY
+ * @pred: receives the largest key smaller than @key found on the path
+ *
+ * Return: 1 if the path is valid, 0 otherwise, 2 if valid and there is no
+ * key smaller than @key
+ */
+static int rb_check_walk(const rb_tree_t *tree, long long key,
+	long long *pred)
+{
+	const rb_tree_t *path[RB_MAX_HEIGHT], *node, *parent = NULL;
+	long long lo = LLONG_MIN, hi = LLONG_MAX, k;
+	size_t len = 0, below = 0;
+	int dir, found = 0;
+
+	for (node = tree; node != NULL; parent = node, node = RB_LINK(node, dir))
+	{
+		k = RB_KEY(node);
+		dir = k < key;
+		if (len == RB_MAX_HEIGHT || !rb_check_near(node, parent, lo, hi, 0))
+			return (0);
+		if (RB_LINK(node, !dir) != NULL && !rb_check_near(RB_LINK(node,
+			!dir), node, dir ? lo : k, dir ? k : hi, 1))
+			return (0);
+		path[len++] = node;
+		if (dir)
+			lo = k, *pred = k, found = 1;
+		else
+			hi = k;
+	}
+	while (len-- > 0)
+	{
+		node = path[len];
+		if (rb_black_height(RB_LINK(node, !(RB_KEY(node) < key))) !=
+			below)
+			return (0);
+		below += RB_COLOR(node) == BLACK;
+	}
+	return (found ? 1 : 2);
+}
+
+/**
+ * rb_check_path - check the nodes an insert or a removal may have changed
+ *
+ * Rotations and color changes of the top-down insert only move nodes on
+ * or next to the search path of the key. A removal also rebalances the
+ * way down to the in-order predecessor of the key, whose key then takes
+ * the removed one's place, so the path of the largest key smaller than
+ * @n is checked as well. Subtrees further away are moved around but left
+ * unchanged inside. Each path costs O(log(n)^2).
+ *
+ * @tree: root of the tree
+ * @n: key inserted or removed
+ *
+ * Return: 1 if the nodes around the paths are valid, 0 otherwise
+ */
+int rb_check_path(const rb_tree_t *tree, int n)
+{
+	long long pred;
+	int valid;
+
+	valid = rb_check_walk(tree, RB_KEY_OF(n), &pred);
+	if (valid == 1)
+		valid = rb_check_walk(tree, pred, &pred);
+	return (valid != 0);
+}
@@ -0,0 +1,21 @@
+#include "rb_trees.h"
+
+#ifdef RB_INTERVAL
+/**
+ * rb_tree_remove_interval - remove an interval from an interval tree
+ *
+ * Both endpoints are needed, since several intervals may start at @lo.
+ *
+ * @root: root of tree
+ * @lo: low endpoint
+ * @hi: high endpoint
+ *
+ * Return: root of tree
+ */
+rb_tree_t *rb_tree_remove_interval(rb_tree_t *root, int lo, int hi)
+{
+	if (hi < lo)
+		return (root);
+	return (rb_tree_remove_key(NULL, root, RB_PAIR_KEY(lo, hi)));
+}
+#endif /* RB_INTERVAL */
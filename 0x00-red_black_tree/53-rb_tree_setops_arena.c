@@ -0,0 +1,80 @@
+#include "rb_trees.h"
+
+/**
+ * rb_setop_run - run a set operation on two whole trees
+ *
+ * @arena: arena the nodes of both trees came from, or NULL for malloc
+ * @op: kind of set operation
+ * @a: root of the first tree, consumed
+ * @b: root of the second tree, consumed
+ *
+ * Return: root of the resulting tree
+ */
+static rb_tree_t *rb_setop_run(rb_arena_t *arena, int op, rb_tree_t *a,
+	rb_tree_t *b)
+{
+	rb_setop_t job;
+
+	job.op = op;
+	job.arena = arena;
+	job.a.root = a;
+	job.a.bh = rb_black_height(a);
+	job.b.root = b;
+	job.b.bh = rb_black_height(b);
+	job.result.root = NULL;
+	job.result.bh = 0;
+	job.depth = 0;
+	rb_setop(&job);
+	return (job.result.root);
+}
+
+/**
+ * rb_tree_union_arena - merge two RB trees whose nodes belong to an arena
+ * into the tree of keys found in either
+ *
+ * Nodes of duplicate keys are released to the arena. An arena can't be
+ * shared between threads, so the work stays on the calling thread.
+ *
+ * @arena: arena the nodes of both trees came from, or NULL for malloc
+ * @a: root of the first tree, consumed
+ * @b: root of the second tree, consumed
+ *
+ * Return: root of the union
+ */
+rb_tree_t *rb_tree_union_arena(rb_arena_t *arena, rb_tree_t *a,
+	rb_tree_t *b)
+{
+	return (rb_setop_run(arena, RB_UNION, a, b));
+}
+
+/**
+ * rb_tree_intersection_arena - merge two RB trees whose nodes belong to an
+ * arena into the tree of keys found in both
+ *
+ * @arena: arena the nodes of both trees came from, or NULL for malloc
+ * @a: root of the first tree, consumed
+ * @b: root of the second tree, consumed
+ *
+ * Return: root of the intersection
+ */
+rb_tree_t *rb_tree_intersection_arena(rb_arena_t *arena, rb_tree_t *a,
+	rb_tree_t *b)
+{
+	return (rb_setop_run(arena, RB_INTERSECTION, a, b));
+}
+
+/**
+ * rb_tree_difference_arena - remove from an RB tree whose nodes belong to
+ * an arena every key found in another
+ *
+ * @arena: arena the nodes of both trees came from, or NULL for malloc
+ * @a: root of the tree to remove keys from, consumed
+ * @b: root of the tree of keys to remove, consumed
+ *
+ * Return: root of the difference
+ */
+rb_tree_t *rb_tree_difference_arena(rb_arena_t *arena, rb_tree_t *a,
+	rb_tree_t *b)
+{
+	return (rb_setop_run(arena, RB_DIFFERENCE, a, b));
+}
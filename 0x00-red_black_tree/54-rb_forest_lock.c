@@ -0,0 +1,74 @@
+#include "rb_forest.h"
+
+/**
+ * rb_forest_lock - lock the shard a key belongs to
+ *
+ * The key is routed without any lock, then checked against the bounds of
+ * the shard found once it is locked. The bounds of a shard only move with
+ * its lock held, so if the key is within them the shard stays the right
+ * one until it is unlocked. Otherwise the boundaries moved in between and
+ * the key is routed again.
+ *
+ * @forest: forest
+ * @n: key
+ * @index: receives the index of the shard, may be NULL
+ *
+ * Return: the shard, locked
+ */
+rb_shard_t *rb_forest_lock(rb_forest_t *forest, int n, size_t *index)
+{
+	rb_shard_t *shard;
+	size_t i;
+
+	for (;;)
+	{
+		i = rb_forest_route(forest, n);
+		shard = &forest->shards[i];
+		pthread_mutex_lock(&shard->lock);
+		if ((i == 0 || atomic_load_explicit(&forest->bounds[i - 1],
+			memory_order_relaxed) <= n) && (i + 1 == forest->n_shards ||
+			atomic_load_explicit(&forest->bounds[i],
+			memory_order_relaxed) > n))
+			break;
+		pthread_mutex_unlock(&shard->lock);
+	}
+	if (index != NULL)
+		*index = i;
+	return (shard);
+}
+
+/**
+ * rb_forest_count - sum the sizes and update counts of the shards,
+ * locking each shard in turn
+ *
+ * Keys moving between shards may be counted twice or missed unless the
+ * balance lock is held.
+ *
+ * @forest: forest
+ * @updates: receives the updates of all shards, may be NULL
+ * @largest: receives the size of the largest shard, may be NULL
+ *
+ * Return: number of keys
+ */
+size_t rb_forest_count(rb_forest_t *forest, size_t *updates,
+	size_t *largest)
+{
+	rb_shard_t *shard;
+	size_t i, total = 0, sum = 0, max = 0;
+
+	for (i = 0; i < forest->n_shards; i++)
+	{
+		shard = &forest->shards[i];
+		pthread_mutex_lock(&shard->lock);
+		total += shard->size;
+		sum += shard->updates;
+		if (shard->size > max)
+			max = shard->size;
+		pthread_mutex_unlock(&shard->lock);
+	}
+	if (updates != NULL)
+		*updates = sum;
+	if (largest != NULL)
+		*largest = max;
+	return (total);
+}
@@ -0,0 +1,104 @@
+#include "rb_trees.h"
+
+/**
+ * rb_build_loop - run the phases of a parallel build on a worker thread,
+ * until the build stops it
+ *
+ * @arg: share of the thread, an rb_build_share_t
+ *
+ * Return: @arg
+ */
+static void *rb_build_loop(void *arg)
+{
+	rb_build_share_t *share = arg;
+	rb_build_t *build = share->build;
+
+	pthread_mutex_lock(&build->gate);
+	pthread_mutex_unlock(&build->gate);
+	if (build->threads == 1)
+		return (arg);
+	for (;;)
+	{
+		pthread_barrier_wait(&build->barrier);
+		if (build->phase == -1)
+			return (arg);
+		rb_build_worker(share);
+		pthread_barrier_wait(&build->barrier);
+	}
+}
+
+/**
+ * rb_build_start - start the worker threads of a parallel build, once for
+ * all of its phases
+ *
+ * The workers wait on the gate until the barrier is set up for the threads
+ * that could actually be started, which become the threads of the build.
+ * If none could, the calling thread runs every phase alone.
+ *
+ * @build: the build, with its number of threads and its shares
+ */
+void rb_build_start(rb_build_t *build)
+{
+	size_t i, started = 1;
+
+	build->ids = malloc(sizeof(*build->ids) * build->threads);
+	if (build->ids != NULL && pthread_mutex_init(&build->gate, NULL))
+		free(build->ids), build->ids = NULL;
+	if (build->ids == NULL)
+	{
+		build->threads = 1;
+		return;
+	}
+	pthread_mutex_lock(&build->gate);
+	while (started < build->threads &&
+		pthread_create(build->ids + started, NULL, rb_build_loop,
+		build->shares + started) == 0)
+		started++;
+	build->threads = started;
+	if (started > 1 && pthread_barrier_init(&build->barrier, NULL, started))
+		build->threads = 1;
+	pthread_mutex_unlock(&build->gate);
+	if (build->threads == 1)
+		for (i = 1; i < started; i++)
+			pthread_join(build->ids[i], NULL);
+}
+
+/**
+ * rb_build_run - run a phase of a parallel build on every thread, and wait
+ * for all of them to finish
+ *
+ * @build: the build, its workers started
+ * @phase: phase to run
+ */
+void rb_build_run(rb_build_t *build, int phase)
+{
+	build->phase = phase;
+	if (build->threads > 1)
+		pthread_barrier_wait(&build->barrier);
+	rb_build_worker(build->shares);
+	if (build->threads > 1)
+		pthread_barrier_wait(&build->barrier);
+}
+
+/**
+ * rb_build_stop - stop the worker threads of a parallel build
+ *
+ * @build: the build, its workers started
+ */
+void rb_build_stop(rb_build_t *build)
+{
+	size_t i;
+
+	if (build->threads > 1)
+	{
+		build->phase = -1;
+		pthread_barrier_wait(&build->barrier);
+		for (i = 1; i < build->threads; i++)
+			pthread_join(build->ids[i], NULL);
+		pthread_barrier_destroy(&build->barrier);
+	}
+	if (build->ids != NULL)
+		pthread_mutex_destroy(&build->gate);
+	free(build->ids);
+	build->ids = NULL;
+}
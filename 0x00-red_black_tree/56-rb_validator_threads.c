@@ -0,0 +1,106 @@
+#include "rb_trees.h"
+
+/**
+ * rb_validator_loop - check a worker thread's share of every full check
+ * of a validator, until the validator stops it
+ *
+ * @arg: share of the thread, an rb_validate_t
+ *
+ * Return: @arg
+ */
+static void *rb_validator_loop(void *arg)
+{
+	rb_validate_t *share = arg;
+	rb_validator_t *validator = share->validator;
+
+	pthread_mutex_lock(&validator->gate);
+	pthread_mutex_unlock(&validator->gate);
+	if (validator->threads == 1)
+		return (arg);
+	for (;;)
+	{
+		pthread_barrier_wait(&validator->barrier);
+		if (validator->stop)
+			return (arg);
+		rb_validate_worker(share);
+		pthread_barrier_wait(&validator->barrier);
+	}
+}
+
+/**
+ * rb_validator_start - start the worker threads of a validator, once for
+ * all of its full checks
+ *
+ * The workers wait on the gate until the barrier is set up for the threads
+ * that could actually be started, which become the threads of the
+ * validator. If none could, the calling thread checks alone.
+ *
+ * @validator: the validator, with its number of threads and its shares
+ */
+void rb_validator_start(rb_validator_t *validator)
+{
+	pthread_t *ids = NULL;
+	size_t i, started = 1;
+
+	validator->stop = 0;
+	if (validator->threads > 1)
+		ids = malloc(sizeof(*ids) * validator->threads);
+	if (ids != NULL && pthread_mutex_init(&validator->gate, NULL))
+		free(ids), ids = NULL;
+	validator->ids = ids;
+	if (validator->ids == NULL)
+	{
+		validator->threads = 1;
+		return;
+	}
+	pthread_mutex_lock(&validator->gate);
+	while (started < validator->threads && pthread_create(ids + started,
+		NULL, rb_validator_loop, validator->shares + started) == 0)
+		started++;
+	validator->threads = started;
+	if (started > 1 &&
+		pthread_barrier_init(&validator->barrier, NULL, started))
+		validator->threads = 1;
+	pthread_mutex_unlock(&validator->gate);
+	if (validator->threads == 1)
+		for (i = 1; i < started; i++)
+			pthread_join(ids[i], NULL);
+}
+
+/**
+ * rb_validator_run - check every share of a full check, and wait for all
+ * the threads to finish
+ *
+ * @validator: the validator, its shares filled in
+ */
+void rb_validator_run(rb_validator_t *validator)
+{
+	if (validator->threads > 1)
+		pthread_barrier_wait(&validator->barrier);
+	rb_validate_worker(validator->shares);
+	if (validator->threads > 1)
+		pthread_barrier_wait(&validator->barrier);
+}
+
+/**
+ * rb_validator_stop - stop the worker threads of a validator
+ *
+ * @validator: the validator, its workers started
+ */
+void rb_validator_stop(rb_validator_t *validator)
+{
+	size_t i;
+
+	if (validator->threads > 1)
+	{
+		validator->stop = 1;
+		pthread_barrier_wait(&validator->barrier);
+		for (i = 1; i < validator->threads; i++)
+			pthread_join(validator->ids[i], NULL);
+		pthread_barrier_destroy(&validator->barrier);
+	}
+	if (validator->ids != NULL)
+		pthread_mutex_destroy(&validator->gate);
+	free(validator->ids);
+	validator->ids = NULL;
+}
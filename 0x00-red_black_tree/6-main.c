@@ -0,0 +1,39 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+void rb_tree_print(const rb_tree_t *tree);
+
+/**
+ * main - Entry point
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree;
+    int sorted[] = {
+        2, 20, 21, 22, 32, 34, 47, 68, 79, 84,
+        87, 91
+    };
+    int unsorted[] = {
+        79, 47, 68, 87, 84, 91, 21, 32, 34, 2,
+        20, 22, 47, 2
+    };
+    size_t n = sizeof(sorted) / sizeof(sorted[0]);
+    size_t m = sizeof(unsorted) / sizeof(unsorted[0]);
+
+    tree = sorted_array_to_rb_tree(sorted, n);
+    if (!tree)
+        return (1);
+    rb_tree_print(tree);
+    printf("Is valid: %d\n", rb_tree_is_valid(tree));
+    rb_tree_delete(tree);
+
+    tree = array_to_rb_tree(unsorted, m);
+    if (!tree)
+        return (1);
+    rb_tree_print(tree);
+    printf("Is valid: %d\n", rb_tree_is_valid(tree));
+    rb_tree_delete(tree);
+    return (0);
+}
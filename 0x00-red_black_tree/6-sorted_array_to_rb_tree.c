@@ -0,0 +1,82 @@
+#include "rb_trees.h"
+
+/**
+ * sorted_array_to_rb_tree - build an RB tree from a strictly ascending array
+ * in linear time
+ *
+ * The tree is perfectly balanced: every node is black except the ones on
+ * the deepest level, which are red, so every path holds the same number of
+ * black nodes and no red node has a red parent.
+ *
+ * @array: strictly ascending array of keys
+ * @size: size of array
+ *
+ * Return: root node of RB-tree, NULL on failure
+ */
+rb_tree_t *sorted_array_to_rb_tree(const int *array, size_t size)
+{
+	return (sorted_array_to_rb_tree_arena(NULL, array, size));
+}
+
+/**
+ * sorted_array_to_rb_tree_arena - build an RB tree from a strictly ascending
+ * array in linear time, taking the nodes from an arena
+ *
+ * @arena: arena to allocate nodes from, or NULL to use malloc
+ * @array: strictly ascending array of keys
+ * @size: size of array
+ *
+ * Return: root node of RB-tree, NULL on failure
+ */
+rb_tree_t *sorted_array_to_rb_tree_arena(rb_arena_t *arena,
+	const int *array, size_t size)
+{
+	size_t red_depth, i;
+
+	if (array == NULL || size == 0)
+		return (NULL);
+	/* Depth of the deepest level is floor(log2(size)) */
+	for (red_depth = 0, i = size; i > 1; i >>= 1)
+		red_depth++;
+
+	return (rb_tree_build_r(arena, array, size, NULL, 0, red_depth));
+}
+
+/**
+ * rb_tree_build_r - recursively build a balanced subtree from the middle out
+ *
+ * @arena: arena to allocate nodes from, or NULL to use malloc
+ * @array: strictly ascending array of keys for this subtree
+ * @size: size of array
+ * @parent: parent of the subtree root
+ * @depth: depth of the subtree root
+ * @red_depth: depth whose nodes are colored red
+ *
+ * Return: root of the subtree, NULL on failure
+ */
+rb_tree_t *rb_tree_build_r(rb_arena_t *arena, const int *array, size_t size,
+	rb_tree_t *parent, size_t depth, size_t red_depth)
+{
+	rb_tree_t *node;
+	size_t mid = size / 2;
+
+	if (size == 0)
+		return (NULL);
+	node = rb_arena_node(arena, parent, array[mid],
+		(depth && depth == red_depth) ? RED : BLACK);
+	if (node == NULL)
+		return (NULL);
+	node->left = rb_tree_build_r(arena, array, mid, node, depth + 1,
+		red_depth);
+	node->right = rb_tree_build_r(arena, array + mid + 1, size - mid - 1,
+		node, depth + 1, red_depth);
+	if ((mid && node->left == NULL) ||
+		(size - mid - 1 && node->right == NULL))
+	{
+		rb_tree_delete_arena(arena, node);
+		return (NULL);
+	}
+	RB_AUGMENT(node);
+
+	return (node);
+}
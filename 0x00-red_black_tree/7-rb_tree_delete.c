@@ -0,0 +1,44 @@
+#include "rb_trees.h"
+
+/**
+ * rb_tree_delete - free every node of an RB tree
+ *
+ * Left children are rotated up until the current node has none, so the
+ * tree is consumed as a list without recursion or extra memory.
+ *
+ * @tree: root of the tree to free
+ */
+void rb_tree_delete(rb_tree_t *tree)
+{
+	rb_tree_delete_arena(NULL, tree);
+}
+
+/**
+ * rb_tree_delete_arena - release every node of an RB tree to its arena
+ *
+ * A tree whose arena is not shared with other trees is released faster
+ * by rb_arena_destroy.
+ *
+ * @arena: arena the nodes came from, or NULL if they came from malloc
+ * @tree: root of the tree to release
+ */
+void rb_tree_delete_arena(rb_arena_t *arena, rb_tree_t *tree)
+{
+	rb_tree_t *next;
+
+	while (tree != NULL)
+	{
+		if (tree->left != NULL)
+		{
+			next = tree->left;
+			tree->left = next->right;
+			next->right = tree;
+		}
+		else
+		{
+			next = tree->right;
+			rb_arena_free(arena, tree);
+		}
+		tree = next;
+	}
+}
@@ -0,0 +1,42 @@
+#include "rb_trees.h"
+
+/**
+ * rb_arena_create - create an arena handing out RB tree nodes from slabs
+ *
+ * @slab_size: number of nodes per slab, RB_ARENA_SLAB if 0
+ *
+ * Return: pointer to the arena, NULL on failure
+ */
+rb_arena_t *rb_arena_create(size_t slab_size)
+{
+	rb_arena_t *arena;
+
+	arena = malloc(sizeof(*arena));
+	if (arena == NULL)
+		return (NULL);
+	arena->slabs = NULL;
+	arena->free_list = NULL;
+	arena->slab_size = slab_size ? slab_size : RB_ARENA_SLAB;
+	arena->used = arena->slab_size;
+	return (arena);
+}
+
+/**
+ * rb_arena_destroy - free an arena together with every node it handed out,
+ * which releases any tree built from it without walking the nodes
+ *
+ * @arena: arena to destroy
+ */
+void rb_arena_destroy(rb_arena_t *arena)
+{
+	rb_slab_t *slab, *next;
+
+	if (arena == NULL)
+		return;
+	for (slab = arena->slabs; slab != NULL; slab = next)
+	{
+		next = slab->next;
+		free(slab);
+	}
+	free(arena);
+}
@@ -0,0 +1,33 @@
+#include <stdlib.h>
+#include "rb_trees.h"
+
+void rb_tree_print(const rb_tree_t *tree);
+
+/**
+ * main - Entry point, build with -DRB_ORDER_STAT
+ *
+ * Return: 0 on success, error code on failure
+ */
+int main(void)
+{
+    rb_tree_t *tree;
+    int array[] = {
+        79, 47, 68, 87, 84, 91, 21, 32, 34, 2,
+        20, 22, 98, 1, 62, 95
+    };
+    size_t n = sizeof(array) / sizeof(array[0]);
+    size_t k;
+
+    tree = array_to_rb_tree(array, n);
+    if (!tree)
+        return (1);
+    tree = rb_tree_remove(tree, 68);
+    rb_tree_print(tree);
+    for (k = 0; k < tree->size; k += 5)
+        printf("Select %lu: %d\n", k, rb_tree_select(tree, k)->n);
+    printf("Rank of 50: %lu\n", rb_tree_rank(tree, 50));
+    printf("Rank of 84: %lu\n", rb_tree_rank(tree, 84));
+    printf("Keys in [20, 90]: %lu\n", rb_tree_count_range(tree, 20, 90));
+    rb_tree_delete(tree);
+    return (0);
+}
@@ -0,0 +1,113 @@
+#include "rb_trees.h"
+
+/**
+ * rb_augment - recompute the augmented fields of a node from its children
+ *
+ * @node: node to update
+ */
+void rb_augment(rb_tree_t *node)
+{
+#ifdef RB_ORDER_STAT
+	node->size = RB_COUNT(node) + RB_SIZE(node->left) +
+		RB_SIZE(node->right);
+#endif
+#ifdef RB_INTERVAL
+	node->max = node->hi;
+	if (node->left != NULL && node->left->max > node->max)
+		node->max = node->left->max;
+	if (node->right != NULL && node->right->max > node->max)
+		node->max = node->right->max;
+#endif
+	(void)node;
+}
+
+/**
+ * rb_augment_path - recompute the augmented fields of a node and all of its
+ * ancestors, after the subtree below @node changed
+ *
+ * @node: lowest node whose subtree changed
+ */
+void rb_augment_path(rb_tree_t *node)
+{
+	for (; node != NULL; node = RB_PARENT(node))
+		rb_augment(node);
+}
+
+#ifdef RB_ORDER_STAT
+/**
+ * rb_tree_rank - count the keys of an RB tree smaller than a value
+ *
+ * @tree: root of the tree
+ * @n: value to rank
+ *
+ * Return: number of keys strictly smaller than @n, which is the index @n
+ * has or would have in sorted order
+ */
+size_t rb_tree_rank(const rb_tree_t *tree, int n)
+{
+	size_t rank = 0;
+
+	while (tree != NULL)
+	{
+		if (tree->n < n)
+		{
+			rank += RB_SIZE(tree->left) + RB_COUNT(tree);
+			tree = tree->right;
+		}
+		else
+			tree = tree->left;
+	}
+	return (rank);
+}
+
+/**
+ * rb_tree_select - find the k-th smallest key of an RB tree
+ *
+ * @tree: root of the tree
+ * @k: index of the key in sorted order, starting at 0
+ *
+ * Return: node holding the key, NULL if the tree has @k keys or fewer
+ */
+rb_tree_t *rb_tree_select(rb_tree_t *tree, size_t k)
+{
+	size_t left;
+
+	while (tree != NULL)
+	{
+		left = RB_SIZE(tree->left);
+		if (k < left)
+			tree = tree->left;
+		else if (k < left + RB_COUNT(tree))
+			return (tree);
+		else
+		{
+			k -= left + RB_COUNT(tree);
+			tree = tree->right;
+		}
+	}
+	return (NULL);
+}
+
+/**
+ * rb_tree_count_range - count the keys of an RB tree in a closed range
+ *
+ * @tree: root of the tree
+ * @lo: lower bound of the range
+ * @hi: upper bound of the range
+ *
+ * Return: number of keys k such that @lo <= k <= @hi
+ */
+size_t rb_tree_count_range(const rb_tree_t *tree, int lo, int hi)
+{
+	size_t below_lo, upto_hi;
+
+	if (lo > hi)
+		return (0);
+	below_lo = rb_tree_rank(tree, lo);
+	if (hi == INT_MAX)
+		upto_hi = RB_SIZE(tree);
+	else
+		upto_hi = rb_tree_rank(tree, hi + 1);
+	return (upto_hi - below_lo);
+}
+#endif /* RB_ORDER_STAT */
@@ -0,0 +1,48 @@
+#ifndef _BP_TREES_H_
+#define _BP_TREES_H_
+
+#include "rb_trees.h"
+
+#define BP_KEYS	32
+#define BP_MIN	(BP_KEYS / 2 - 1)
+
+/**
+ * struct bp_tree_s - B+tree node, an alternative to rb_tree_t for large
+ * key sets
+ *
+ * @keys: Sorted keys, the unused tail is filled with INT_MAX so a node
+ * can be searched without looking at @count. Inner nodes hold separators:
+ * every key below children[i] is smaller than keys[i], and every key below
+ * children[i + 1] is at least keys[i]
+ * @count: Number of keys in use
+ * @leaf: 1 for a leaf, 0 for an inner node
+ * @next: Next leaf in key order, leaves only
+ * @children: Child nodes, inner nodes only. Leaves are allocated without
+ * this array
+ *
+ * Nodes are aligned on cache lines and @keys fills exactly two of them.
+ * Every node but the root holds at least BP_MIN keys.
+ */
+typedef struct bp_tree_s
+{
+	int keys[BP_KEYS];
+	uint32_t count;
+	uint32_t leaf;
+	struct bp_tree_s *next;
+	struct bp_tree_s *children[BP_KEYS + 1];
+} bp_tree_t;
+
+bp_tree_t *bp_tree_node(int leaf);
+size_t bp_tree_upper(const bp_tree_t *node, int n);
+void bp_tree_delete(bp_tree_t *tree);
+bp_tree_t *bp_tree_insert(bp_tree_t **tree, int n);
+bp_tree_t *bp_tree_remove(bp_tree_t *root, int n);
+bp_tree_t *bp_tree_find(bp_tree_t *tree, int n);
+size_t bp_tree_foreach_range(bp_tree_t *tree, int lo, int hi,
+	void (*action)(int n, void *data), void *data);
+bp_tree_t *array_to_bp_tree(int *array, size_t size);
+
+int bp_split_child(bp_tree_t *parent, size_t i);
+size_t bp_fix_child(bp_tree_t *parent, size_t i);
+
+#endif /* _BP_TREES_H_ */
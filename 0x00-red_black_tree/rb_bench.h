@@ -0,0 +1,38 @@
+#ifndef _RB_BENCH_H_
+#define _RB_BENCH_H_
+
+#include "rb_trees.h"
+
+#define RB_BENCH_ZIPF_THETA	0.99
+
+/**
+ * enum rb_workload_e - Key sequences the benchmarks run on
+ *
+ * @RB_SEQUENTIAL: 0 to n - 1 in ascending order
+ * @RB_RANDOM: 0 to n - 1 in random order
+ * @RB_ZIPF: n draws from a Zipfian distribution over n keys, so a few hot
+ * keys come back again and again. Ranks are hashed so hot keys are spread
+ * over the whole key space
+ * @RB_ADVERSARIAL: 0 to n - 1 alternating between the smallest and the
+ * largest key left, so inserts land on the innermost paths of the tree
+ * and rotate more than any other workload
+ * @RB_WORKLOADS: number of workloads
+ */
+typedef enum rb_workload_e
+{
+	RB_SEQUENTIAL = 0,
+	RB_RANDOM,
+	RB_ZIPF,
+	RB_ADVERSARIAL,
+	RB_WORKLOADS
+} rb_workload_t;
+
+int *rb_bench_keys(rb_workload_t workload, size_t n, uint64_t seed);
+
+double rb_bench_now(void);
+int rb_bench_perf_open(void);
+void rb_bench_perf_start(int fd);
+long long rb_bench_perf_stop(int fd);
+long rb_bench_peak_rss(int reset);
+
+#endif /* _RB_BENCH_H_ */
@@ -0,0 +1,73 @@
+#ifndef _RB_FOREST_H_
+#define _RB_FOREST_H_
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "rb_trees.h"
+
+#define RB_FOREST_REBALANCE	4096
+#define RB_FOREST_SLACK	64
+
+/**
+ * struct rb_shard_s - One tree of a forest, with its own lock. The padding
+ * keeps the locks of neighbouring shards on separate cache lines
+ *
+ * @lock: Serializes access to the tree, its counters and its bounds
+ * @root: Root of the tree
+ * @size: Number of nodes in the tree
+ * @updates: Inserts and removals since the forest was created
+ * @pad: Padding
+ */
+typedef struct rb_shard_s
+{
+	pthread_mutex_t lock;
+	rb_tree_t *root;
+	size_t size;
+	size_t updates;
+	char pad[RB_CACHE_LINE];
+} rb_shard_t;
+
+/**
+ * struct rb_forest_s - Set of ints partitioned by key range into
+ * independently locked RB trees
+ *
+ * Shard i holds the keys in [bounds[i - 1], bounds[i]), the first and last
+ * shards being unbounded below and above. Bound i only changes with shards
+ * i and i + 1 locked, so an operation routes its key without any lock,
+ * locks the shard found and checks the key is still within its bounds.
+ *
+ * @shards: Shards, in key order
+ * @n_shards: Number of shards
+ * @bounds: Smallest key of each shard but the first
+ * @balance: Serializes balance checks and boundary moves
+ * @every: Updates of a shard between two balance checks
+ * @checked: Updates of all shards summed at the last balance check
+ */
+typedef struct rb_forest_s
+{
+	rb_shard_t *shards;
+	size_t n_shards;
+	atomic_int *bounds;
+	pthread_mutex_t balance;
+	size_t every;
+	size_t checked;
+} rb_forest_t;
+
+rb_forest_t *rb_forest_create(size_t n_shards, int lo, int hi);
+void rb_forest_destroy(rb_forest_t *forest);
+int rb_forest_insert(rb_forest_t *forest, int n);
+int rb_forest_remove(rb_forest_t *forest, int n);
+int rb_forest_find(rb_forest_t *forest, int n);
+size_t rb_forest_foreach_range(rb_forest_t *forest, int lo, int hi,
+	void (*action)(const rb_tree_t *node, void *data), void *data);
+size_t rb_forest_size(rb_forest_t *forest);
+void rb_forest_rebalance(rb_forest_t *forest);
+
+size_t rb_forest_route(const rb_forest_t *forest, int n);
+rb_shard_t *rb_forest_lock(rb_forest_t *forest, int n, size_t *index);
+size_t rb_forest_count(rb_forest_t *forest, size_t *updates,
+	size_t *largest);
+void rb_forest_updated(rb_forest_t *forest);
+void rb_forest_spread(rb_forest_t *forest);
+
+#endif /* _RB_FOREST_H_ */
@@ -0,0 +1,305 @@
+#ifndef _RB_GENERIC_H_
+#define _RB_GENERIC_H_
+
+#include "rb_trees.h"
+
+/*
+ * Red-Black trees specialised at compile time for a key type, a value type
+ * and a comparator. Everything is generated as static inline functions, so
+ * the comparator is inlined on the hot path and nodes hold the key and the
+ * value directly. RB_COMPACT and the augmentation options only apply to
+ * rb_tree_t, generated nodes always keep a plain color field.
+ *
+ * RB_GENERATE(name, key_type, value_type, cmp) defines:
+ *
+ * name_node_t: node with key, value, parent, left, right and color fields
+ * name_t: tree with root and size fields
+ * void name_init(name_t *tree)
+ * name_node_t *name_find(const name_t *tree, key_type key)
+ * name_node_t *name_lower_bound(const name_t *tree, key_type key)
+ * name_node_t *name_first(const name_t *tree)
+ * name_node_t *name_next(name_node_t *node)
+ * name_node_t *name_insert(name_t *tree, key_type key, value_type value)
+ * int name_remove(name_t *tree, key_type key)
+ * void name_clear(name_t *tree)
+ *
+ * @cmp is a function or macro called as cmp(a, b), returning a negative
+ * number, 0 or a positive number when a is smaller than, equal to or
+ * larger than b. RB_CMP_NUM works for any arithmetic key type, strcmp for
+ * NUL-terminated string keys.
+ *
+ * name_insert stores the value in the existing node when the key is
+ * already present. It returns the node holding the key, NULL on failure.
+ * name_remove returns 1 if the key was removed, 0 if it was not present.
+ * Like rb_tree_remove, removing a key with two children moves the key and
+ * value of its successor into its node.
+ */
+
+#define RB_CMP_NUM(a, b)	(((a) > (b)) - ((a) < (b)))
+#define RB_GEN_IS_RED(node)	((node) != NULL && (node)->color == RED)
+
+#define RB_GENERATE(name, key_type, value_type, cmp)			\
+	RB_GENERATE_TYPES(name, key_type, value_type)			\
+	RB_GENERATE_FIND(name, key_type, cmp)				\
+	RB_GENERATE_WALK(name)						\
+	RB_GENERATE_ROTATE(name)					\
+	RB_GENERATE_INSERT(name, key_type, value_type, cmp)		\
+	RB_GENERATE_REMOVE(name, key_type)
+
+#define RB_GENERATE_TYPES(name, key_type, value_type)			\
+typedef struct name##_node_s						\
+{									\
+	key_type key;							\
+	value_type value;						\
+	struct name##_node_s *parent;					\
+	struct name##_node_s *left;					\
+	struct name##_node_s *right;					\
+	rb_color_t color;						\
+} name##_node_t;							\
+									\
+typedef struct name##_s							\
+{									\
+	name##_node_t *root;						\
+	size_t size;							\
+} name##_t;								\
+									\
+static inline void name##_init(name##_t *tree)				\
+{									\
+	tree->root = NULL;						\
+	tree->size = 0;							\
+}
+
+#define RB_GENERATE_FIND(name, key_type, cmp)				\
+static inline name##_node_t *name##_find(const name##_t *tree,		\
+	key_type key)							\
+{									\
+	name##_node_t *node = tree->root;				\
+	int c;								\
+									\
+	while (node != NULL)						\
+	{								\
+		c = cmp(key, node->key);				\
+		if (c == 0)						\
+			return (node);					\
+		node = c < 0 ? node->left : node->right;		\
+	}								\
+	return (NULL);							\
+}									\
+									\
+static inline name##_node_t *name##_lower_bound(const name##_t *tree,	\
+	key_type key)							\
+{									\
+	name##_node_t *node = tree->root, *bound = NULL;		\
+									\
+	while (node != NULL)						\
+	{								\
+		if (cmp(node->key, key) < 0)				\
+			node = node->right;				\
+		else							\
+		{							\
+			bound = node;					\
+			node = node->left;				\
+		}							\
+	}								\
+	return (bound);							\
+}
+
+#define RB_GENERATE_WALK(name)						\
+static inline name##_node_t *name##_first(const name##_t *tree)		\
+{									\
+	name##_node_t *node = tree->root;				\
+									\
+	while (node != NULL && node->left != NULL)			\
+		node = node->left;					\
+	return (node);							\
+}									\
+									\
+static inline name##_node_t *name##_next(name##_node_t *node)		\
+{									\
+	if (node->right != NULL)					\
+	{								\
+		for (node = node->right; node->left != NULL;		\
+			node = node->left)				\
+			;						\
+		return (node);						\
+	}								\
+	while (node->parent != NULL && node->parent->right == node)	\
+		node = node->parent;					\
+	return (node->parent);						\
+}									\
+									\
+static inline void name##_clear(name##_t *tree)				\
+{									\
+	name##_node_t *node = tree->root, *next;			\
+									\
+	while (node != NULL)						\
+	{								\
+		if (node->left != NULL)					\
+		{							\
+			next = node->left;				\
+			node->left = next->right;			\
+			next->right = node;				\
+		}							\
+		else							\
+		{							\
+			next = node->right;				\
+			free(node);					\
+		}							\
+		node = next;						\
+	}								\
+	name##_init(tree);						\
+}
+
+#define RB_GENERATE_ROTATE(name)					\
+static inline void name##_rotate(name##_t *tree, name##_node_t *node,	\
+	int dir)							\
+{									\
+	name##_node_t *top = RB_LINK(node, !dir);			\
+									\
+	RB_LINK(node, !dir) = RB_LINK(top, dir);			\
+	if (RB_LINK(top, dir) != NULL)					\
+		RB_LINK(top, dir)->parent = node;			\
+	top->parent = node->parent;					\
+	if (node->parent == NULL)					\
+		tree->root = top;					\
+	else								\
+		RB_LINK(node->parent, node->parent->right == node) = top; \
+	RB_LINK(top, dir) = node;					\
+	node->parent = top;						\
+}
+
+#define RB_GENERATE_INSERT(name, key_type, value_type, cmp)		\
+static inline void name##_insert_fixup(name##_t *tree,			\
+	name##_node_t *node)						\
+{									\
+	name##_node_t *p, *g, *u;					\
+	int dir;							\
+									\
+	while ((p = node->parent) != NULL && p->color == RED)		\
+	{								\
+		g = p->parent;						\
+		dir = g->right == p;					\
+		u = RB_LINK(g, !dir);					\
+		if (RB_GEN_IS_RED(u))					\
+		{							\
+			p->color = u->color = BLACK;			\
+			g->color = RED;					\
+			node = g;					\
+			continue;					\
+		}							\
+		if (RB_LINK(p, !dir) == node)				\
+		{							\
+			name##_rotate(tree, p, dir);			\
+			p = node;					\
+		}							\
+		p->color = BLACK;					\
+		g->color = RED;						\
+		name##_rotate(tree, g, !dir);				\
+		break;							\
+	}								\
+	tree->root->color = BLACK;					\
+}									\
+									\
+static inline name##_node_t *name##_insert(name##_t *tree,		\
+	key_type key, value_type value)					\
+{									\
+	name##_node_t **link = &tree->root, *parent = NULL, *node;	\
+	int c;								\
+									\
+	while (*link != NULL)						\
+	{								\
+		parent = *link;						\
+		c = cmp(key, parent->key);				\
+		if (c == 0)						\
+		{							\
+			parent->value = value;				\
+			return (parent);				\
+		}							\
+		link = c < 0 ? &parent->left : &parent->right;		\
+	}								\
+	node = malloc(sizeof(*node));					\
+	if (node == NULL)						\
+		return (NULL);						\
+	node->key = key;						\
+	node->value = value;						\
+	node->parent = parent;						\
+	node->left = node->right = NULL;				\
+	node->color = RED;						\
+	*link = node;							\
+	tree->size++;							\
+	name##_insert_fixup(tree, node);				\
+	return (node);							\
+}
+
+#define RB_GENERATE_REMOVE(name, key_type)				\
+static inline void name##_remove_fixup(name##_t *tree,			\
+	name##_node_t *x, name##_node_t *parent)			\
+{									\
+	name##_node_t *w;						\
+	int dir;							\
+									\
+	while (x != tree->root && !RB_GEN_IS_RED(x))			\
+	{								\
+		dir = parent->right == x;				\
+		w = RB_LINK(parent, !dir);				\
+		if (w->color == RED)					\
+		{							\
+			w->color = BLACK;				\
+			parent->color = RED;				\
+			name##_rotate(tree, parent, dir);		\
+			w = RB_LINK(parent, !dir);			\
+		}							\
+		if (!RB_GEN_IS_RED(w->left) && !RB_GEN_IS_RED(w->right)) \
+		{							\
+			w->color = RED;					\
+			x = parent;					\
+			parent = x->parent;				\
+			continue;					\
+		}							\
+		if (!RB_GEN_IS_RED(RB_LINK(w, !dir)))			\
+		{							\
+			RB_LINK(w, dir)->color = BLACK;			\
+			w->color = RED;					\
+			name##_rotate(tree, w, !dir);			\
+			w = RB_LINK(parent, !dir);			\
+		}							\
+		w->color = parent->color;				\
+		parent->color = BLACK;					\
+		RB_LINK(w, !dir)->color = BLACK;			\
+		name##_rotate(tree, parent, dir);			\
+		x = tree->root;						\
+	}								\
+	if (x != NULL)							\
+		x->color = BLACK;					\
+}									\
+									\
+static inline int name##_remove(name##_t *tree, key_type key)		\
+{									\
+	name##_node_t *node, *y, *child;				\
+									\
+	node = name##_find(tree, key);					\
+	if (node == NULL)						\
+		return (0);						\
+	if (node->left != NULL && node->right != NULL)			\
+	{								\
+		for (y = node->right; y->left != NULL; y = y->left)	\
+			;						\
+		node->key = y->key;					\
+		node->value = y->value;					\
+		node = y;						\
+	}								\
+	child = node->left != NULL ? node->left : node->right;		\
+	if (child != NULL)						\
+		child->parent = node->parent;				\
+	if (node->parent == NULL)					\
+		tree->root = child;					\
+	else								\
+		RB_LINK(node->parent, node->parent->right == node) = child; \
+	if (node->color == BLACK)					\
+		name##_remove_fixup(tree, child, node->parent);		\
+	free(node);							\
+	tree->size--;							\
+	return (1);							\
+}
+
+#endif /* _RB_GENERIC_H_ */
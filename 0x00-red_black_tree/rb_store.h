@@ -0,0 +1,108 @@
+#ifndef _RB_STORE_H_
+#define _RB_STORE_H_
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "rb_trees.h"
+
+#define RB_STORE_READERS	64
+#define RB_COW_DEPTH	132
+#define RB_COW_NODES	(RB_COW_DEPTH * 4)
+#define RB_COW_MARK	(&rb_cow_mark)
+
+/**
+ * struct rb_cow_s - State of one copy-on-write update of a persistent tree
+ *
+ * @root: Root of the new version
+ * @path: Search path from the root, every node on it already copied
+ * @dirs: Direction taken from each node of @path
+ * @depth: Number of nodes on @path
+ * @fresh: Nodes created by this update, private until it is published
+ * @n_fresh: Number of nodes in @fresh
+ * @retired: Nodes of the old version replaced by this update
+ * @n_retired: Number of nodes in @retired
+ *
+ * Nodes of a persistent tree are shared between versions, so their parent
+ * links are meaningless and never followed. While an update runs, the
+ * parent field of its own copies holds RB_COW_MARK instead, to tell them
+ * apart from shared nodes in O(1).
+ */
+typedef struct rb_cow_s
+{
+	rb_tree_t *root;
+	rb_tree_t *path[RB_COW_DEPTH];
+	int dirs[RB_COW_DEPTH];
+	long depth;
+	rb_tree_t *fresh[RB_COW_NODES];
+	size_t n_fresh;
+	rb_tree_t *retired[RB_COW_NODES];
+	size_t n_retired;
+} rb_cow_t;
+
+/**
+ * struct rb_retired_s - Nodes unlinked by one update, freed once no reader
+ * can still see them. The node pointers follow the header
+ *
+ * @next: Next, older, batch of retired nodes
+ * @epoch: Epoch the nodes were retired in
+ * @count: Number of nodes in the batch
+ */
+typedef struct rb_retired_s
+{
+	struct rb_retired_s *next;
+	unsigned long epoch;
+	size_t count;
+} rb_retired_t;
+
+/**
+ * struct rb_reader_s - Reader slot, padded to its own cache line
+ *
+ * @epoch: Epoch the reader entered in, 0 when the slot is free
+ * @pad: Padding
+ */
+typedef struct rb_reader_s
+{
+	atomic_ulong epoch;
+	char pad[RB_CACHE_LINE - sizeof(atomic_ulong)];
+} rb_reader_t;
+
+/**
+ * struct rb_store_s - Persistent RB tree shared by lock-free readers and
+ * serialized writers
+ *
+ * @root: Root of the current version
+ * @epoch: Global epoch, advanced by every update
+ * @readers: Reader slots
+ * @lock: Serializes writers
+ * @retired: Batches of retired nodes waiting for readers to move on
+ */
+typedef struct rb_store_s
+{
+	rb_tree_t *_Atomic root;
+	atomic_ulong epoch;
+	rb_reader_t readers[RB_STORE_READERS];
+	pthread_mutex_t lock;
+	rb_retired_t *retired;
+} rb_store_t;
+
+extern rb_tree_t rb_cow_mark;
+
+rb_store_t *rb_store_create(rb_tree_t *root);
+void rb_store_destroy(rb_store_t *store);
+rb_tree_t *rb_snapshot_acquire(rb_store_t *store, int *slot);
+void rb_snapshot_release(rb_store_t *store, int slot);
+int rb_store_insert(rb_store_t *store, int n);
+int rb_store_remove(rb_store_t *store, int n);
+
+void rb_store_reclaim(rb_store_t *store);
+rb_tree_t *rb_cow_node(rb_cow_t *cow, rb_tree_t *node);
+rb_tree_t *rb_cow_child(rb_cow_t *cow, rb_tree_t *parent, int dir);
+int rb_cow_path(rb_cow_t *cow);
+void rb_cow_link(rb_cow_t *cow, long i, rb_tree_t *node);
+rb_tree_t *rb_cow_rotate(rb_tree_t *node, int dir);
+int rb_cow_count(rb_cow_t *cow, rb_tree_t *node, int up);
+int rb_cow_insert(rb_cow_t *cow, int n);
+int rb_cow_remove(rb_cow_t *cow, int n);
+int rb_cow_remove_fixup(rb_cow_t *cow, rb_tree_t *x);
+
+#endif /* _RB_STORE_H_ */
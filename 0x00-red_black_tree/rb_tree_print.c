@@ -17,14 +17,15 @@
  */
 static int rb_print_t(const rb_tree_t *tree, int offset, int depth, char **s)
 {
-	char b[12];
+	char b[16];
 	int width, left, right, i;
 	int is_left;
 
 	if (!tree)
 		return (0);
-	is_left = (tree->parent && tree->parent->left == tree);
-	width = sprintf(b, "%c(%03d)", (tree->color == RED ? 'R' : 'B'), tree->n);
+	is_left = (RB_PARENT(tree) && RB_PARENT(tree)->left == tree);
+	width = sprintf(b, "%c(%03d)", (RB_COLOR(tree) == RED ? 'R' : 'B'),
+		tree->n);
 	left = rb_print_t(tree->left, offset, depth + 1, s);
 	right = rb_print_t(tree->right, offset + left + width, depth + 1, s);
 	for (i = 0; i < width; i++)
@@ -61,6 +62,23 @@ static size_t rb_height(const rb_tree_t *tree)
 	return (height_l > height_r ? height_l : height_r);
 }
 
+/**
+ * rb_width - Measures the width of the drawing of a binary tree
+ *
+ * @tree: Pointer to the node to measure the drawing of
+ *
+ * Return: The number of columns the tree takes
+ */
+static size_t rb_width(const rb_tree_t *tree)
+{
+	char b[16];
+
+	if (!tree)
+		return (0);
+	return (sprintf(b, "%c(%03d)", (RB_COLOR(tree) == RED ? 'R' : 'B'),
+		tree->n) + rb_width(tree->left) + rb_width(tree->right));
+}
+
 /**
  * rb_tree_print - Prints a red-black tree
  *
@@ -69,25 +87,26 @@ static size_t rb_height(const rb_tree_t *tree)
 void rb_tree_print(const rb_tree_t *tree)
 {
 	char **s;
-	size_t height, i, j;
+	size_t height, width, i, j;
 
 	if (!tree)
 		return;
+	width = rb_width(tree) + 1;
 	height = rb_height(tree);
 	s = malloc(sizeof(*s) * (height + 1));
 	if (!s)
 		return;
 	for (i = 0; i < height + 1; i++)
 	{
-		s[i] = malloc(sizeof(**s) * 255);
+		s[i] = malloc(sizeof(**s) * width);
 		if (!s[i])
 			return;
-		memset(s[i], 32, 255);
+		memset(s[i], 32, width);
 	}
 	rb_print_t(tree, 0, 0, s);
 	for (i = 0; i < height + 1; i++)
 	{
-		for (j = 254; j > 1; --j)
+		for (j = width - 1; j > 1; --j)
 		{
 			if (s[i][j] != ' ')
 				break;
@@ -3,11 +3,145 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <stdint.h>
+#include <pthread.h>
 
 #define COLOR_SWAP		1
 #define NO_COLOR_SWAP	0
 
-#define IS_RED(node)	(node != NULL && node->color == RED)
+#define RB_ARENA_SLAB	1024
+#define RB_FIND_BATCH	16
+#define RB_SETOP_FORK_DEPTH	3
+#define RB_SETOP_FORK_BH	16
+#define RB_VALIDATE_JOBS	8
+#define RB_VALIDATOR_PATHS	4096
+#define RB_MAX_HEIGHT	128
+#define RB_BATCH_REBUILD	8
+#define RB_SORT_RADIX	256
+#define RB_BUILD_JOBS	4
+#define RB_BUILD_BUCKETS	256
+#define RB_BUILD_SAMPLES	16
+#define RB_BUILD_MIN	65536
+#define RB_CACHE_LINE	64
+#define RB_IMAGE_MAGIC	0x31544252
+#define RB_IMAGE_KEYS	64
+
+/*
+ * Color and parent accessors. With RB_COMPACT the color lives in the low
+ * bits of the parent pointer, which nodes' alignment leaves unused.
+ */
+#ifdef RB_COMPACT
+#define RB_COLOR_MASK	((uintptr_t)3)
+#define RB_COLOR(node)	((rb_color_t)((node)->parent_color & RB_COLOR_MASK))
+#define RB_PARENT(node)	\
+	((rb_tree_t *)((node)->parent_color & ~RB_COLOR_MASK))
+#define RB_SET_COLOR(node, c)	((node)->parent_color = \
+	((node)->parent_color & ~RB_COLOR_MASK) | (uintptr_t)(c))
+#define RB_SET_PARENT(node, p)	((node)->parent_color = \
+	(uintptr_t)(p) | ((node)->parent_color & RB_COLOR_MASK))
+#define RB_SET_PARENT_COLOR(node, p, c)	\
+	((node)->parent_color = (uintptr_t)(p) | (uintptr_t)(c))
+#else
+#define RB_COLOR(node)	((node)->color)
+#define RB_PARENT(node)	((node)->parent)
+#define RB_SET_COLOR(node, c)	((node)->color = (c))
+#define RB_SET_PARENT(node, p)	((node)->parent = (p))
+#define RB_SET_PARENT_COLOR(node, p, c)	\
+	((node)->parent = (p), (node)->color = (c))
+#endif
+
+#define IS_RED(node)	(node != NULL && RB_COLOR(node) == RED)
+#define RB_LINK(node, dir)	(*((dir) ? &(node)->right : &(node)->left))
+
+#ifdef __GNUC__
+#define RB_PREFETCH(addr)	__builtin_prefetch(addr)
+#else
+#define RB_PREFETCH(addr)	((void)(addr))
+#endif
+
+/*
+ * RB_MULTISET keeps one node per distinct key with its number of
+ * occurrences: insert counts one more and remove one less, and the node is
+ * only freed when its count drops to zero. RB_MOVE_KEY copies the key and
+ * its count when a removal moves a key into another node.
+ */
+#if defined(RB_MULTISET) && defined(RB_INTERVAL)
+#error "RB_MULTISET and RB_INTERVAL can't be combined"
+#endif
+
+#ifdef RB_MULTISET
+#define RB_COUNT(node)	((size_t)(node)->count)
+#define RB_MOVE_KEY(dst, src)	((dst)->n = (src)->n, (dst)->count = (src)->count)
+#elif defined(RB_INTERVAL)
+#define RB_COUNT(node)	((size_t)1)
+#define RB_MOVE_KEY(dst, src)	((dst)->n = (src)->n, (dst)->hi = (src)->hi)
+#else
+#define RB_COUNT(node)	((size_t)1)
+#define RB_MOVE_KEY(dst, src)	((dst)->n = (src)->n)
+#endif
+
+/*
+ * RB_KEY is what nodes are ordered by, and RB_KEY_OF the key of a plain
+ * value. Intervals are ordered by low then high endpoint, packed into one
+ * long long, so several of them can start at the same value. A plain value
+ * n stands for the interval [n, n], and RB_KEY_LAST(n) is the key of the
+ * last interval starting at n, [n, INT_MAX].
+ */
+#ifdef RB_INTERVAL
+#define RB_PAIR_KEY(lo, hi)	((long long)(lo) * 4294967296LL + \
+	((long long)(hi) - (lo)) + 1)
+#define RB_KEY(node)	RB_PAIR_KEY((node)->n, (node)->hi)
+#define RB_KEY_OF(n)	RB_PAIR_KEY(n, n)
+#define RB_KEY_LAST(n)	RB_PAIR_KEY(n, INT_MAX)
+#else
+#define RB_KEY(node)	((long long)(node)->n)
+#define RB_KEY_OF(n)	((long long)(n))
+#define RB_KEY_LAST(n)	((long long)(n))
+#endif
+
+/*
+ * Optional per-node augmentations, enabled at compile time:
+ * RB_ORDER_STAT keeps subtree sizes for rank and select queries, counting
+ * every occurrence in multiset mode.
+ * RB_INTERVAL turns each node into the interval [n, hi] and keeps the
+ * largest high endpoint of every subtree for overlap queries.
+ * RB_AUGMENT recomputes a node's augmented fields from its children and
+ * compiles to nothing when no augmentation is enabled.
+ */
+#ifdef RB_ORDER_STAT
+#define RB_AUGMENTED
+#define RB_SIZE(node)	((node) != NULL ? (size_t)(node)->size : 0)
+#endif
+
+#ifdef RB_INTERVAL
+#define RB_AUGMENTED
+#endif
+
+#ifdef RB_AUGMENTED
+#define RB_AUGMENT(node)	rb_augment(node)
+#define RB_AUGMENT_PATH(node)	rb_augment_path(node)
+#else
+#define RB_AUGMENT(node)	((void)0)
+#define RB_AUGMENT_PATH(node)	((void)0)
+#endif
+
+/*
+ * RB_STATS counts the work done by the rebalancing code in rb_stats, one
+ * set of counters per thread. RB_STAT and its friends compile to nothing
+ * without it, so the counters cost nothing unless they are asked for.
+ */
+#ifdef RB_STATS
+#define RB_STAT(field, n)	((void)(rb_stats.field += (n)))
+#define RB_STAT_DESCENT()	((void)(rb_stats.descents++, rb_stats.depth = 0))
+#define RB_STAT_STEP()	((void)(rb_stats.path_length++, \
+	++rb_stats.depth > rb_stats.max_depth ? \
+	(rb_stats.max_depth = rb_stats.depth) : 0))
+#else
+#define RB_STAT(field, n)	((void)0)
+#define RB_STAT_DESCENT()	((void)0)
+#define RB_STAT_STEP()	((void)0)
+#endif
 
 /**
  * enum rb_color_e - Possible color of a Red-Black tree
@@ -31,16 +165,411 @@ typedef enum rb_color_e
  * @left: Pointer to the left child node
  * @right: Pointer to the right child node
  * @color: Color of the node (RED or BLACK)
+ * @parent_color: Parent pointer with the color in its low bits (RB_COMPACT)
+ * @size: Number of keys in the subtree rooted at this node (RB_ORDER_STAT)
+ * @count: Number of occurrences of @n (RB_MULTISET)
+ * @hi: High endpoint of the interval [n, hi] (RB_INTERVAL)
+ * @max: Largest high endpoint in the subtree (RB_INTERVAL)
+ *
+ * Always go through RB_COLOR, RB_PARENT and their setters to reach the
+ * color and parent, so code works with both layouts. The compact layout
+ * reuses the 32 bits left after @n for the augmented fields.
  */
 typedef struct rb_tree_s
 {
 	int n;
+#ifdef RB_COMPACT
+#ifdef RB_ORDER_STAT
+	uint32_t size;
+#elif defined(RB_MULTISET)
+	uint32_t count;
+#endif
+	uintptr_t parent_color;
+#else
 	rb_color_t color;
 	struct rb_tree_s *parent;
+#endif
 	struct rb_tree_s *left;
 	struct rb_tree_s *right;
+#if defined(RB_ORDER_STAT) && !defined(RB_COMPACT)
+	size_t size;
+#endif
+#if defined(RB_MULTISET) && (!defined(RB_COMPACT) || defined(RB_ORDER_STAT))
+	size_t count;
+#endif
+#ifdef RB_INTERVAL
+	int hi;
+	int max;
+#endif
 } rb_tree_t;
 
+/**
+ * struct rb_slab_s - Block of nodes carved out by an arena, the nodes
+ * follow the header in the same allocation
+ *
+ * @next: Pointer to the previously allocated slab
+ */
+typedef struct rb_slab_s
+{
+	struct rb_slab_s *next;
+} rb_slab_t;
+
+/**
+ * struct rb_arena_s - Node allocator owning the nodes of one or more trees
+ *
+ * @slabs: List of slabs, newest first
+ * @free_list: Released nodes, chained through their right pointer
+ * @slab_size: Number of nodes per slab
+ * @used: Number of nodes handed out of the newest slab
+ */
+typedef struct rb_arena_s
+{
+	rb_slab_t *slabs;
+	rb_tree_t *free_list;
+	size_t slab_size;
+	size_t used;
+} rb_arena_t;
+
+/**
+ * struct rb_frozen_s - Read-only copy of the keys of an RB tree, laid out
+ * in Eytzinger (breadth-first) order
+ *
+ * @keys: Keys, keys[1] is the root and keys[2k], keys[2k + 1] the
+ * children of keys[k]. Aligned so that each cache line holds one node
+ * and its descendants four levels down
+ * @size: Number of keys
+ * @map: Mapped image file the keys live in, NULL if they were allocated
+ * @map_size: Size of the mapping
+ */
+typedef struct rb_frozen_s
+{
+	int *keys;
+	size_t size;
+	void *map;
+	size_t map_size;
+} rb_frozen_t;
+
+/**
+ * struct rb_image_s - Header of a saved tree image. The keys follow at
+ * offset RB_IMAGE_KEYS, in the layout of rb_frozen_t
+ *
+ * @magic: RB_IMAGE_MAGIC, also tells the byte order apart
+ * @key_size: Size of a key in bytes
+ * @size: Number of keys
+ */
+typedef struct rb_image_s
+{
+	uint32_t magic;
+	uint32_t key_size;
+	uint64_t size;
+} rb_image_t;
+
+/**
+ * struct rb_stats_s - Counters of the rebalancing work done by a thread
+ * (RB_STATS)
+ *
+ * @rotations: Single rotations, a double rotation counts two
+ * @double_rotations: Double rotations
+ * @color_flips: Color flips, on insert and on remove
+ * @red_fixes: Red violations repaired by a rotation on insert
+ * @push_downs: Black nodes made red ahead of a removal
+ * @descents: Top-down insert and remove passes
+ * @path_length: Nodes visited by all the passes
+ * @max_depth: Deepest node visited by a pass
+ * @depth: Depth of the pass in progress
+ */
+typedef struct rb_stats_s
+{
+	size_t rotations;
+	size_t double_rotations;
+	size_t color_flips;
+	size_t red_fixes;
+	size_t push_downs;
+	size_t descents;
+	size_t path_length;
+	size_t max_depth;
+	size_t depth;
+} rb_stats_t;
+
+/**
+ * enum rb_setop_kind_e - Kinds of set operations between two trees
+ *
+ * @RB_UNION: keys found in either tree
+ * @RB_INTERSECTION: keys found in both trees
+ * @RB_DIFFERENCE: keys of the first tree not found in the second
+ */
+typedef enum rb_setop_kind_e
+{
+	RB_UNION = 0,
+	RB_INTERSECTION,
+	RB_DIFFERENCE
+} rb_setop_kind_t;
+
+/**
+ * struct rb_part_s - RB tree together with its black height, carried
+ * through splits and joins so the height is never counted again
+ *
+ * @root: Root of the tree, black
+ * @bh: Black height of @root, 0 for an empty tree
+ */
+typedef struct rb_part_s
+{
+	rb_tree_t *root;
+	size_t bh;
+} rb_part_t;
+
+/**
+ * struct rb_setop_s - Set operation job, run directly or on a worker thread
+ *
+ * @op: Kind of set operation
+ * @arena: Arena the nodes of both trees came from, NULL for malloc
+ * @a: First tree
+ * @b: Second tree
+ * @result: Resulting tree, filled in by rb_setop
+ * @depth: Recursion depth, limits how deep jobs are forked to threads
+ */
+typedef struct rb_setop_s
+{
+	int op;
+	rb_arena_t *arena;
+	rb_part_t a;
+	rb_part_t b;
+	rb_part_t result;
+	int depth;
+} rb_setop_t;
+
+/**
+ * struct rb_check_s - Subtree waiting to be checked by the validator
+ *
+ * @node: Root of the subtree
+ * @parent: Parent @node must point to
+ * @lo: Every key of the subtree must be larger
+ * @hi: Every key of the subtree must be smaller
+ * @blacks: Number of black nodes above @node
+ */
+typedef struct rb_check_s
+{
+	const rb_tree_t *node;
+	const rb_tree_t *parent;
+	long long lo;
+	long long hi;
+	size_t blacks;
+} rb_check_t;
+
+/**
+ * struct rb_validate_s - Share of the subtrees checked by one thread
+ *
+ * @validator: Validator the thread belongs to, a struct rb_validator_s
+ * @checks: All the subtrees to check
+ * @count: Number of subtrees
+ * @first: Index of the first subtree of this share
+ * @stride: Distance between two subtrees of this share
+ * @height: Black nodes on every path down to a leaf, 0 until one is found
+ * @valid: 1 if the subtrees of the share are valid, 0 if one isn't, -1 if
+ * memory ran out
+ */
+typedef struct rb_validate_s
+{
+	struct rb_validator_s *validator;
+	const rb_check_t *checks;
+	size_t count;
+	size_t first;
+	size_t stride;
+	size_t height;
+	int valid;
+} rb_validate_t;
+
+/**
+ * struct rb_validator_s - Incremental validator, re-checks only the
+ * search paths of the keys inserted or removed since the last check
+ *
+ * @keys: Keys touched since the last check
+ * @count: Number of keys in @keys
+ * @threads: Threads used for a full check, the calling one included
+ * @shares: One share per thread
+ * @ids: Worker threads, from index 1, kept from one check to the next
+ * @gate: Held while the workers are started
+ * @barrier: Where the threads meet before and after each full check
+ * @stop: Set to stop the workers
+ * @full: If not 0, the next check covers the whole tree. Set it after any
+ * operation other than an insert or a removal, such as a join or a split
+ */
+typedef struct rb_validator_s
+{
+	int *keys;
+	size_t count;
+	size_t threads;
+	rb_validate_t *shares;
+	pthread_t *ids;
+	pthread_mutex_t gate;
+	pthread_barrier_t barrier;
+	int stop;
+	int full;
+} rb_validator_t;
+
+/**
+ * enum rb_dump_format_e - Output formats of rb_tree_dump
+ *
+ * @RB_DUMP_LEVELS: One line per level, nodes from left to right
+ * @RB_DUMP_DOT: Graphviz digraph
+ * @RB_DUMP_JSON: Nested JSON objects
+ */
+typedef enum rb_dump_format_e
+{
+	RB_DUMP_LEVELS = 0,
+	RB_DUMP_DOT,
+	RB_DUMP_JSON
+} rb_dump_format_t;
+
+/**
+ * struct rb_dump_s - State of a tree dump
+ *
+ * @stream: Stream written to
+ * @levels: Number of levels shown, deeper nodes are only counted
+ * @depth: Depth of the node being visited
+ * @target: Level printed by the current pass of RB_DUMP_LEVELS
+ * @nodes: Number of nodes
+ * @red: Number of red nodes
+ * @height: Depth of the deepest node
+ * @hidden: Number of nodes below the levels shown
+ * @below: @hidden when the hidden subtree being visited was entered
+ */
+typedef struct rb_dump_s
+{
+	FILE *stream;
+	size_t levels;
+	size_t depth;
+	size_t target;
+	size_t nodes;
+	size_t red;
+	size_t height;
+	size_t hidden;
+	size_t below;
+} rb_dump_t;
+
+/**
+ * struct rb_usage_s - Shape of an RB tree and memory its nodes take
+ *
+ * @nodes: Number of nodes
+ * @height: Number of nodes on the longest path from the root to a leaf
+ * @black_height: Number of black nodes on every path to a leaf
+ * @bytes: Bytes taken by the nodes, allocator overhead included
+ * @average_depth: Average depth of the nodes, the root is at depth 0
+ */
+typedef struct rb_usage_s
+{
+	size_t nodes;
+	size_t height;
+	size_t black_height;
+	size_t bytes;
+	double average_depth;
+} rb_usage_t;
+
+/**
+ * enum rb_layout_e - Orders nodes can be laid out in by rb_tree_compact
+ *
+ * @RB_IN_ORDER: Sorted order, for range scans
+ * @RB_BREADTH_FIRST: Level by level, for lookups from the root
+ */
+typedef enum rb_layout_e
+{
+	RB_IN_ORDER = 0,
+	RB_BREADTH_FIRST
+} rb_layout_t;
+
+/**
+ * struct rb_build_job_s - Subtree below the spine of a parallel build
+ *
+ * @keys: Strictly ascending keys of the subtree
+ * @size: Number of keys
+ * @parent: Spine node the subtree hangs from
+ * @link: Child link of @parent receiving the subtree
+ */
+typedef struct rb_build_job_s
+{
+	const int *keys;
+	size_t size;
+	rb_tree_t *parent;
+	rb_tree_t **link;
+} rb_build_job_t;
+
+/**
+ * struct rb_build_share_s - Part of a parallel build done by one thread
+ *
+ * @build: The whole build, a struct rb_build_s
+ * @id: Index of the thread, its chunk of the input, its buckets and its
+ * subtrees are the ones equal to @id modulo the number of threads
+ * @counts: Keys of the chunk in each bucket, then where the next one goes
+ */
+typedef struct rb_build_share_s
+{
+	struct rb_build_s *build;
+	size_t id;
+	size_t counts[RB_BUILD_BUCKETS];
+} rb_build_share_t;
+
+/**
+ * struct rb_build_s - State of array_to_rb_tree_parallel
+ *
+ * @array: Input keys
+ * @size: Number of input keys
+ * @buckets: Bucket of each input key, RB_BUILD_BUCKETS being a power of 2
+ * no larger than UCHAR_MAX + 1
+ * @keys: Input keys grouped by bucket, then sorted within each bucket
+ * @sorted: Strictly ascending keys
+ * @runs: Occurrences of each key of @sorted (RB_MULTISET)
+ * @threads: Number of threads, the calling one included
+ * @shares: One share per thread
+ * @ids: Worker threads, from index 1
+ * @gate: Held while the workers are started
+ * @barrier: Where the threads meet before and after each phase
+ * @phase: Step every thread runs next, -1 to stop the workers
+ * @splitters: Keys between the buckets, each one starting a bucket
+ * @starts: Start of each bucket in @keys
+ * @firsts: Start of each bucket in @sorted
+ * @jobs: Subtrees below the spine
+ * @count: Number of subtrees in @jobs
+ * @split: Depth of the subtrees below the spine
+ * @red_depth: Depth whose nodes are colored red
+ */
+typedef struct rb_build_s
+{
+	const int *array;
+	size_t size;
+	unsigned char *buckets;
+	int *keys;
+	int *sorted;
+	size_t *runs;
+	size_t threads;
+	rb_build_share_t *shares;
+	pthread_t *ids;
+	pthread_mutex_t gate;
+	pthread_barrier_t barrier;
+	int phase;
+	int splitters[RB_BUILD_BUCKETS - 1];
+	size_t starts[RB_BUILD_BUCKETS + 1];
+	size_t firsts[RB_BUILD_BUCKETS + 1];
+	rb_build_job_t *jobs;
+	size_t count;
+	size_t split;
+	size_t red_depth;
+} rb_build_t;
+
+/**
+ * struct rb_hint_s - Where the last hinted insert went, see
+ * rb_tree_insert_hint. Start with every field 0
+ *
+ * @node: Node of the last value inserted, NULL to search from the root
+ * @near: In-order predecessor and successor of @node, NULL past either end
+ * @known: Bit 0 set if @near[0] is up to date, bit 1 if @near[1] is
+ */
+typedef struct rb_hint_s
+{
+	rb_tree_t *node;
+	rb_tree_t *near[2];
+	int known;
+} rb_hint_t;
+
 /**
  * struct rb_insert_ret_s - Reb-Black tree insert return value
  *
@@ -55,22 +584,141 @@ typedef struct rb_insert_ret_s
 
 rb_tree_t *rb_tree_node(rb_tree_t *parent, int value, rb_color_t color);
 int rb_tree_is_valid(const rb_tree_t *tree);
+int rb_tree_validate(const rb_tree_t *tree, size_t threads);
+rb_validator_t *rb_validator_create(size_t threads);
+void rb_validator_destroy(rb_validator_t *validator);
+void rb_validator_touch(rb_validator_t *validator, int n);
+int rb_validator_check(rb_validator_t *validator, const rb_tree_t *tree);
+int rb_validator_full(rb_validator_t *validator, const rb_tree_t *tree);
+void rb_validator_start(rb_validator_t *validator);
+void rb_validator_run(rb_validator_t *validator);
+void rb_validator_stop(rb_validator_t *validator);
+void rb_validate_worker(rb_validate_t *share);
 rb_tree_t *rb_tree_insert(rb_tree_t **tree, int value);
 rb_tree_t *array_to_rb_tree(int *array, size_t size);
+rb_tree_t *array_to_rb_tree_parallel(int *array, size_t size, size_t threads);
 rb_tree_t *rb_tree_remove(rb_tree_t *root, int n);
+rb_tree_t *sorted_array_to_rb_tree(const int *array, size_t size);
+void rb_tree_delete(rb_tree_t *tree);
+
+rb_arena_t *rb_arena_create(size_t slab_size);
+void rb_arena_destroy(rb_arena_t *arena);
+rb_tree_t *rb_arena_node(rb_arena_t *arena, rb_tree_t *parent, int value,
+	rb_color_t color);
+void rb_arena_free(rb_arena_t *arena, rb_tree_t *node);
+rb_tree_t *rb_tree_insert_arena(rb_arena_t *arena, rb_tree_t **tree, int n);
+rb_tree_t *array_to_rb_tree_arena(rb_arena_t *arena, int *array, size_t size);
+rb_tree_t *sorted_array_to_rb_tree_arena(rb_arena_t *arena,
+	const int *array, size_t size);
+rb_tree_t *rb_tree_remove_arena(rb_arena_t *arena, rb_tree_t *root, int n);
+rb_tree_t *rb_tree_remove_key(rb_arena_t *arena, rb_tree_t *root,
+	long long key);
+void rb_tree_delete_arena(rb_arena_t *arena, rb_tree_t *tree);
+rb_tree_t *rb_tree_find(rb_tree_t *tree, int n);
+size_t rb_tree_find_many(rb_tree_t *tree, const int *keys, size_t n,
+	rb_tree_t **out);
+rb_tree_t *rb_tree_lower_bound(rb_tree_t *tree, int n);
+rb_tree_t *rb_tree_next(rb_tree_t *node);
+rb_tree_t *rb_tree_prev(rb_tree_t *node);
+size_t rb_tree_foreach_range(rb_tree_t *tree, int lo, int hi,
+	void (*action)(const rb_tree_t *node, void *data), void *data);
+rb_tree_t *rb_tree_join(rb_tree_t *left, rb_tree_t *pivot, rb_tree_t *right);
+rb_tree_t *rb_tree_split(rb_tree_t *tree, int n, rb_tree_t **lo,
+	rb_tree_t **hi);
+rb_tree_t *rb_tree_concat(rb_tree_t *left, rb_tree_t *right);
+rb_tree_t *rb_tree_union(rb_tree_t *a, rb_tree_t *b);
+rb_tree_t *rb_tree_intersection(rb_tree_t *a, rb_tree_t *b);
+rb_tree_t *rb_tree_difference(rb_tree_t *a, rb_tree_t *b);
+rb_tree_t *rb_tree_union_arena(rb_arena_t *arena, rb_tree_t *a,
+	rb_tree_t *b);
+rb_tree_t *rb_tree_intersection_arena(rb_arena_t *arena, rb_tree_t *a,
+	rb_tree_t *b);
+rb_tree_t *rb_tree_difference_arena(rb_arena_t *arena, rb_tree_t *a,
+	rb_tree_t *b);
+rb_tree_t *rb_tree_insert_hint(rb_tree_t **tree, rb_hint_t *hint, int n);
+size_t rb_tree_insert_batch(rb_tree_t **tree, const int *keys, size_t n);
+void rb_sort_keys(int *keys, size_t n);
+rb_usage_t rb_tree_usage(const rb_tree_t *tree, const rb_arena_t *arena);
+rb_tree_t *rb_tree_compact(rb_arena_t *from, rb_arena_t **to, rb_tree_t *tree,
+	rb_layout_t layout);
+int rb_tree_dump(const rb_tree_t *tree, FILE *stream, rb_dump_format_t format,
+	size_t levels);
+rb_tree_t *rb_tree_remove_range(rb_tree_t *root, int lo, int hi);
+rb_tree_t *rb_tree_remove_range_arena(rb_arena_t *arena, rb_tree_t *root,
+	int lo, int hi);
+rb_frozen_t *rb_tree_freeze(const rb_tree_t *tree);
+rb_tree_t *rb_tree_thaw(const rb_frozen_t *frozen);
+rb_tree_t *rb_tree_thaw_arena(rb_arena_t *arena, const rb_frozen_t *frozen);
+void rb_frozen_free(rb_frozen_t *frozen);
+const int *rb_frozen_lower_bound(const rb_frozen_t *frozen, int n);
+int rb_frozen_find(const rb_frozen_t *frozen, int n);
+int rb_tree_save(const rb_tree_t *tree, const char *path);
+rb_frozen_t *rb_frozen_map(const char *path);
+rb_tree_t *rb_tree_load(const char *path, rb_arena_t **arena);
+
+void rb_augment(rb_tree_t *node);
+void rb_augment_path(rb_tree_t *node);
+
+#ifdef RB_ORDER_STAT
+size_t rb_tree_rank(const rb_tree_t *tree, int n);
+rb_tree_t *rb_tree_select(rb_tree_t *tree, size_t k);
+size_t rb_tree_count_range(const rb_tree_t *tree, int lo, int hi);
+#endif
+
+#ifdef RB_INTERVAL
+rb_tree_t *rb_tree_insert_interval(rb_tree_t **tree, int lo, int hi);
+rb_tree_t *rb_tree_remove_interval(rb_tree_t *root, int lo, int hi);
+rb_tree_t *rb_tree_overlap_any(rb_tree_t *tree, int lo, int hi);
+size_t rb_tree_foreach_overlap(rb_tree_t *tree, int lo, int hi,
+	void (*action)(const rb_tree_t *node, void *data), void *data);
+size_t rb_tree_stab(rb_tree_t *tree, int x,
+	void (*action)(const rb_tree_t *node, void *data), void *data);
+#endif
+
+#ifdef RB_STATS
+extern _Thread_local rb_stats_t rb_stats;
+rb_stats_t rb_stats_get(void);
+void rb_stats_reset(void);
+#endif
+
+size_t rb_black_height(const rb_tree_t *tree);
+rb_part_t rb_join_parts(rb_part_t left, rb_tree_t *pivot, rb_part_t right);
+rb_tree_t *rb_split_parts(rb_part_t tree, long long key, rb_part_t *lo,
+	rb_part_t *hi);
+rb_part_t rb_concat_parts(rb_part_t left, rb_part_t right);
+rb_part_t rb_detach(rb_tree_t *tree, size_t bh);
+int rb_insert_fixup(rb_tree_t **root, rb_tree_t *node);
+rb_tree_t *rb_rotate(rb_tree_t **root, rb_tree_t *node, int dir);
+void *rb_setop(void *arg);
+int rb_check_node(const rb_tree_t *node, const rb_tree_t *parent,
+	long long lo, long long hi);
+int rb_check_path(const rb_tree_t *tree, int n);
+
+void rb_dump_level(rb_dump_t *dump, const rb_tree_t *node, int leave);
+void rb_dump_dot(rb_dump_t *dump, const rb_tree_t *node, int leave);
+void rb_dump_json(rb_dump_t *dump, const rb_tree_t *node, int leave);
+
+rb_tree_t *rb_batch_rebuild(rb_tree_t *tree, size_t size, const int *keys,
+	size_t n, size_t *added);
+void rb_build_start(rb_build_t *build);
+void rb_build_run(rb_build_t *build, int phase);
+void rb_build_stop(rb_build_t *build);
+void rb_build_worker(rb_build_share_t *share);
+#ifdef RB_MULTISET
+const size_t *rb_set_counts(rb_tree_t *node, const size_t *runs);
+#endif
+rb_tree_t *rb_tree_build_r(rb_arena_t *arena, const int *array, size_t size,
+	rb_tree_t *parent, size_t depth, size_t red_depth);
 
-rb_tree_t *rb_tree_remove_r(rb_tree_t *root, int n, int *done);
-int remove_recurse_direction_helper(rb_tree_t *root, int n, int *done);
-rb_tree_t *rb_rebalance(rb_tree_t *root, int direction, int *done);
-void rebalance_red_siblings(
-	int direction, rb_tree_t *p, rb_tree_t *s, rb_tree_t *root, int *done);
+rb_tree_t *rb_rebalance(rb_tree_t *q, rb_tree_t *p, rb_tree_t *g, int dir,
+	int last);
+void rebalance_red_siblings(rb_tree_t *q, rb_tree_t *p, rb_tree_t *g,
+	rb_tree_t *s, int last);
 
-rb_tree_t *rb_tree_insert_r(rb_tree_t *root, rb_tree_t *node);
-rb_tree_t *correct_red_violation(rb_tree_t *root, int direction);
+void repair_red_violation(
+	rb_tree_t *q, rb_tree_t *p, rb_tree_t *t, rb_tree_t *g, int last);
 rb_tree_t *single_rotate_color_swap(
 	rb_tree_t *root, int direction, int color_swap);
-rb_tree_t *single_rotate(rb_tree_t *root, int direction);
 rb_tree_t *double_rotate(rb_tree_t *root, int direction);
-int is_red(rb_tree_t *node);
 
 #endif /* _RB_TREES_H_ */